@@ -0,0 +1,83 @@
+#ifndef BENCHMARK_H
+#define BENCHMARK_H
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <string>
+
+/**
+ * Shared pieces of the timing drivers: a best-of-N timer and a generator for
+ * large, well-typed Prism programs. Identifiers may only contain letters, so
+ * generated names spell their number in base 26.
+ */
+namespace Benchmark
+{
+    /**
+     * Runs the body the given number of times and returns the fastest run in
+     * seconds
+     */
+    template <typename F>
+    double timeBest(int runs, F&& body)
+    {
+        double best = 1e30;
+        for (int i = 0; i < runs; i++)
+        {
+            auto start = std::chrono::steady_clock::now();
+            body();
+            std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+            best = elapsed.count() < best ? elapsed.count() : best;
+        }
+        return best;
+    }
+
+    inline std::string getName(const char* prefix, size_t number)
+    {
+        std::string name = prefix;
+        do
+        {
+            name += (char)('a' + number % 26);
+            number /= 26;
+        } while (number);
+        return name;
+    }
+
+    /**
+     * Returns a program of the given number of functions, each with its own
+     * parameters, locals, loops, branches, calls and string literals
+     */
+    inline std::string generateProgram(size_t functionCount, size_t localsPerFunction)
+    {
+        std::string text;
+        for (size_t f = 0; f < functionCount; f++)
+        {
+            text += "int " + getName("fn", f) + "(int alpha, int beta)\n{\n";
+            for (size_t i = 0; i < localsPerFunction; i++)
+            {
+                std::string local = getName("v", i), previous = i ? getName("v", i - 1) : "alpha";
+                text += "    int " + local + " = " + previous + " * beta + " + std::to_string(i) + ";\n";
+                text += "    while (" + local + " < alpha)\n    {\n";
+                text += "        if (" + local + " >= beta && true)\n        {\n";
+                text += "            " + local + " = " + local + " + 1;\n        }\n";
+                text += "        else\n        {\n            " + local + " = " + local + " - beta / 2;\n        }\n    }\n";
+            }
+            if (f)
+            {
+                text += "    printf(\"%d\\n\", " + getName("fn", f - 1) + "(alpha, beta));\n";
+            }
+            text += "    return " + (localsPerFunction ? getName("v", localsPerFunction - 1) : std::string("alpha")) + ";\n}\n\n";
+        }
+        text += "int main()\n{\n    return " + getName("fn", functionCount ? functionCount - 1 : 0) + "(1, 2);\n}\n";
+        return text;
+    }
+
+    /**
+     * Writes the text to a file in the working directory, since the lexer
+     * reads its input from disk, and returns the path
+     */
+    inline std::string writeInput(const std::string& name, const std::string& text)
+    {
+        std::ofstream(name, std::ios::binary) << text;
+        return name;
+    }
+}
+#endif
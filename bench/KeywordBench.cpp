@@ -0,0 +1,104 @@
+#include <cctype>
+#include <cstdio>
+#include <string_view>
+#include <vector>
+#include "Benchmark.h"
+#include "Keywords.h"
+
+/**
+ * The lookup Lexer::lex used before the perfect hash, kept here as the
+ * baseline: a switch on the first character followed by string compares,
+ * including the missing breaks after 'f' and 'r'
+ */
+static SyntaxType lookupBySwitch(std::string_view lexeme)
+{
+    switch (lexeme[0])
+    {
+        case 'b':
+            if (lexeme == "bool") return BoolKeywordToken;
+            break;
+        case 'd':
+            if (lexeme == "double") return DoubleKeywordToken;
+            break;
+        case 'e':
+            if (lexeme == "else") return ElseToken;
+            break;
+        case 'f':
+            if (lexeme == "false") return FalseKeywordToken;
+        case 'i':
+            if (lexeme == "if") return IfToken;
+            else if (lexeme == "int") return IntKeywordToken;
+            break;
+        case 'p':
+            if (lexeme == "print") return PrintToken;
+            break;
+        case 'r':
+            if (lexeme == "return") return ReturnKeyword;
+        case 't':
+            if (lexeme == "true") return TrueKeywordToken;
+            break;
+        case 'v':
+            if (lexeme == "var") return VarKeywordToken;
+            break;
+        case 'w':
+            if (lexeme == "while") return WhileKeywordToken;
+    }
+    return IdentifierToken;
+}
+
+template <typename Lookup>
+static double timePerLexeme(const std::vector<std::string_view>& lexemes, Lookup lookup)
+{
+    const int Rounds = 20;
+    volatile unsigned sink = 0;
+    double seconds = Benchmark::timeBest(5, [&]()
+    {
+        unsigned keywords = 0;
+        for (int round = 0; round < Rounds; round++)
+        {
+            for (std::string_view lexeme : lexemes)
+            {
+                keywords += lookup(lexeme) != IdentifierToken;
+            }
+        }
+        sink = sink + keywords;
+    });
+    return seconds * 1e9 / ((double)lexemes.size() * Rounds);
+}
+
+/**
+ * Splits a generated corpus into its keyword and identifier lexemes and
+ * times both lookups on each group, then on every lexeme in source order,
+ * which is how the lexer sees them
+ */
+int main()
+{
+    std::string text = Benchmark::generateProgram(2000, 20);
+    std::vector<std::string_view> lexemes, keywords, identifiers;
+    for (size_t i = 0; i < text.size();)
+    {
+        if (!isalpha((unsigned char)text[i]))
+        {
+            i++;
+            continue;
+        }
+        size_t start = i;
+        while (i < text.size() && isalpha((unsigned char)text[i]))
+        {
+            i++;
+        }
+        std::string_view lexeme(text.data() + start, i - start);
+        lexemes.push_back(lexeme);
+        (Keywords::lookup(lexeme) == IdentifierToken ? identifiers : keywords).push_back(lexeme);
+    }
+
+    printf("corpus: %zu keywords, %zu identifiers\n", keywords.size(), identifiers.size());
+    printf("%-14s %14s %14s\n", "", "switch ns/op", "hash ns/op");
+    //Lambdas, so that both lookups can be inlined into the timing loop as they are in the lexer
+    auto bySwitch = [](std::string_view lexeme) { return lookupBySwitch(lexeme); };
+    auto byHash = [](std::string_view lexeme) { return Keywords::lookup(lexeme); };
+    printf("%-14s %14.2f %14.2f\n", "keywords", timePerLexeme(keywords, bySwitch), timePerLexeme(keywords, byHash));
+    printf("%-14s %14.2f %14.2f\n", "identifiers", timePerLexeme(identifiers, bySwitch), timePerLexeme(identifiers, byHash));
+    printf("%-14s %14.2f %14.2f\n", "all, in order", timePerLexeme(lexemes, bySwitch), timePerLexeme(lexemes, byHash));
+    return 0;
+}
@@ -0,0 +1,56 @@
+#include <cstdio>
+#include <string>
+#include "Benchmark.h"
+#include "CharScanner.h"
+#include "Interner.h"
+#include "Lexer.h"
+
+static const char* levelNames[] = { "scalar", "SSE2", "AVX2" };
+
+/**
+ * Lexes the whole file and returns the number of tokens
+ */
+static size_t lexFile(const std::string& path)
+{
+    Interner interner;
+    Lexer lexer(path, interner);
+    size_t count = 0;
+    while (lexer.lex().getSyntaxType() != EOFToken)
+    {
+        count++;
+    }
+    return count;
+}
+
+/**
+ * Times the lexer on a large generated program with each kernel level the
+ * CPU supports, then the kernels alone on one long run, where the width of
+ * each step matters most
+ */
+int main()
+{
+    std::string text = Benchmark::generateProgram(6000, 20);
+    std::string path = Benchmark::writeInput("scanner_bench.pr", text);
+    std::string run(text.size(), ' ');
+    double megabytes = text.size() / 1e6;
+    size_t tokens = lexFile(path);
+    printf("%.1f MB, %zu tokens\n", megabytes, tokens);
+    printf("%-8s %14s %14s %14s\n", "kernels", "lexer MB/s", "spaces MB/s", "string MB/s");
+
+    volatile size_t sink = 0;
+    for (int level = CharScanner::Scalar; level <= CharScanner::getSupportedLevel(); level++)
+    {
+        CharScanner::setLevel((CharScanner::Level)level);
+        double lexing = Benchmark::timeBest(5, [&]() { sink = sink + lexFile(path); });
+        double spaces = Benchmark::timeBest(5, [&]()
+        {
+            sink = sink + CharScanner::skipWhitespace(run.data(), 0, run.size());
+        });
+        double string = Benchmark::timeBest(5, [&]()
+        {
+            sink = sink + CharScanner::findQuote(run.data(), 0, run.size());
+        });
+        printf("%-8s %14.0f %14.0f %14.0f\n", levelNames[level], megabytes / lexing, megabytes / spaces, megabytes / string);
+    }
+    return 0;
+}
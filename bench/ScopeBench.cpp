@@ -0,0 +1,138 @@
+#include <cstdio>
+#include <tuple>
+#include <unordered_map>
+#include <vector>
+#include "Benchmark.h"
+#include "ScopedSymbolTable.h"
+#include "Type.h"
+
+/**
+ * The scope tree the parser used before ScopedSymbolTable: a hash map per
+ * scope, searched from the innermost scope outwards. A miss inserts an empty
+ * entry into every scope it passes through, as ScopeTreeNode::getNode did.
+ */
+class ScopeTree
+{
+private:
+    struct Scope
+    {
+        Scope* parent;
+        std::unordered_map<Symbol, std::tuple<Type, ASTNode*, bool>> symbolTable;
+    };
+    std::vector<Scope*> open;
+
+public:
+    ScopeTree()
+    {
+        open.push_back(new Scope{ nullptr, {} });
+    }
+
+    ~ScopeTree()
+    {
+        while (!open.empty())
+        {
+            popScope();
+        }
+    }
+
+    void pushScope()
+    {
+        open.push_back(new Scope{ open.back(), {} });
+    }
+
+    void popScope()
+    {
+        delete open.back();
+        open.pop_back();
+    }
+
+    //Entries kept the type and whether the symbol was a function, which nothing read
+    void declare(Symbol symbol, ASTNode* node)
+    {
+        open.back()->symbolTable[symbol] = std::tuple<Type, ASTNode*, bool>(IntegerPrimitive, node, false);
+    }
+
+    ASTNode* lookup(Symbol symbol)
+    {
+        for (Scope* scope = open.back(); scope; scope = scope->parent)
+        {
+            if (ASTNode* node = std::get<1>(scope->symbolTable[symbol]))
+            {
+                return node;
+            }
+        }
+        return nullptr;
+    }
+};
+
+/**
+ * Replays the symbol traffic of parsing functions whose bodies nest blocks
+ * to the given depth. Every block declares a few locals and then resolves
+ * names declared at every depth so far, plus a global function. Returns the
+ * number of lookups.
+ */
+template <typename Table>
+static size_t parseFunctions(Table& table, size_t functionCount, size_t depth)
+{
+    const Symbol LocalsPerBlock = 4, Global = 0;
+    const size_t LookupsPerBlock = 16;
+    //Any non-null node marks a symbol as declared
+    ASTNode* node = reinterpret_cast<ASTNode*>(&table);
+    size_t lookups = 0, found = 0;
+    for (size_t f = 0; f < functionCount; f++)
+    {
+        table.pushScope();
+        for (size_t level = 0; level < depth; level++)
+        {
+            table.pushScope();
+            for (Symbol local = 0; local < LocalsPerBlock; local++)
+            {
+                table.declare(1 + (Symbol)level * LocalsPerBlock + local, node);
+            }
+            for (size_t i = 0; i < LookupsPerBlock; i++)
+            {
+                size_t target = (i * 7919 + f) % (level + 1);
+                Symbol symbol = i % 4 == 0 ? Global : 1 + (Symbol)(target * LocalsPerBlock + i % LocalsPerBlock);
+                found += table.lookup(symbol) != nullptr;
+                lookups++;
+            }
+        }
+        for (size_t level = 0; level <= depth; level++)
+        {
+            table.popScope();
+        }
+    }
+    return found == lookups ? lookups : 0;
+}
+
+/**
+ * Times both tables at increasing nesting depths, keeping the number of
+ * lookups per row roughly the same
+ */
+int main()
+{
+    printf("%-8s %12s %14s %14s\n", "depth", "lookups", "tree ns/op", "table ns/op");
+    for (size_t depth : { 1, 4, 16, 64, 256 })
+    {
+        size_t functionCount = 1000000 / (depth * 16), lookups = 0;
+        double tree = Benchmark::timeBest(3, [&]()
+        {
+            ScopeTree table;
+            table.declare(0, reinterpret_cast<ASTNode*>(&table));
+            lookups = parseFunctions(table, functionCount, depth);
+        });
+        double flat = Benchmark::timeBest(3, [&]()
+        {
+            ScopedSymbolTable table;
+            table.declare(0, reinterpret_cast<ASTNode*>(&table));
+            lookups = parseFunctions(table, functionCount, depth);
+        });
+        if (!lookups)
+        {
+            printf("a lookup failed\n");
+            return 1;
+        }
+        printf("%-8zu %12zu %14.1f %14.1f\n", depth, lookups, tree * 1e9 / lookups, flat * 1e9 / lookups);
+    }
+    return 0;
+}
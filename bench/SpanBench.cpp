@@ -0,0 +1,174 @@
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <vector>
+#include "Benchmark.h"
+#include "Parser.h"
+#include "StaticVisitor.h"
+
+static size_t allocationCount = 0;
+
+void* operator new(size_t size)
+{
+    allocationCount++;
+    if (void* memory = std::malloc(size ? size : 1))
+    {
+        return memory;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* memory) noexcept
+{
+    std::free(memory);
+}
+
+void operator delete(void* memory, size_t) noexcept
+{
+    std::free(memory);
+}
+
+/**
+ * Hands out a node's children either as the span the accessors now return
+ * or as a copy of the container, which is what they returned before
+ */
+template <bool IsCopying, typename T>
+static auto getChildren(Span<T> children)
+{
+    if constexpr (IsCopying)
+    {
+        return std::vector<T>(children.begin(), children.end());
+    }
+    else
+    {
+        return children;
+    }
+}
+
+/**
+ * Counts the nodes of a tree, reaching list children through getChildren
+ */
+template <bool IsCopying>
+class NodeCounter final : public StaticVisitor<NodeCounter<IsCopying>>
+{
+public:
+    size_t count = 0;
+
+    void descend(ASTNode* node)
+    {
+        if (node)
+        {
+            this->visit(node);
+        }
+    }
+
+    void visitIntegerLiteralNode(IntegerLiteralNode*) { count++; }
+    void visitBooleanLiteralNode(BooleanLiteralNode*) { count++; }
+    void visitStringLiteralNode(StringLiteralNode*) { count++; }
+    void visitVariableNode(VariableNode*) { count++; }
+
+    void visitBinaryOperatorNode(BinaryOperatorNode* node)
+    {
+        count++;
+        descend(node->left);
+        descend(node->right);
+    }
+
+    void visitCompoundStatementNode(CompoundStatementNode* node)
+    {
+        count++;
+        for (ASTNode* statement : getChildren<IsCopying>(node->getStatements()))
+        {
+            descend(statement);
+        }
+    }
+
+    void visitIfStatementNode(IfStatementNode* node)
+    {
+        count++;
+        descend(node->getCondition());
+        descend(node->getIfStmtBody());
+        descend(node->getElseBody());
+    }
+
+    void visitVariableDeclarationNode(VariableDeclarationNode* node)
+    {
+        count++;
+        descend(node->getVarNode());
+        descend(node->getRHS());
+    }
+
+    void visitReturnNode(ReturnNode* node)
+    {
+        count++;
+        descend(node->toReturn);
+    }
+
+    void visitFunctionCallNode(FunctionCallNode* node)
+    {
+        count++;
+        for (ASTNode* argument : getChildren<IsCopying>(node->getArguments()))
+        {
+            descend(argument);
+        }
+    }
+
+    void visitFunctionDeclarationNode(FunctionDeclarationNode* node)
+    {
+        count++;
+        for (auto& parameter : getChildren<IsCopying>(node->getParameterList()))
+        {
+            descend(parameter.first);
+        }
+        descend(node->getFunctionBody());
+    }
+
+    void visitProgramNode(ProgramNode* node)
+    {
+        count++;
+        for (ASTNode* unit : getChildren<IsCopying>(node->getProgramUnits()))
+        {
+            descend(unit);
+        }
+    }
+
+    void visitWhileNode(WhileNode* node)
+    {
+        count++;
+        descend(node->getCondition());
+        descend(node->getBody());
+    }
+};
+
+template <bool IsCopying>
+static void report(const char* name, ASTNode* program)
+{
+    size_t count = 0, allocations = allocationCount;
+    {
+        NodeCounter<IsCopying> counter;
+        counter.descend(program);
+        count = counter.count;
+    }
+    allocations = allocationCount - allocations;
+    double seconds = Benchmark::timeBest(5, [&]()
+    {
+        NodeCounter<IsCopying> counter;
+        counter.descend(program);
+    });
+    printf("%-10s %10zu %12zu %10.2f\n", name, count, allocations, seconds * 1e3);
+}
+
+/**
+ * Walks the tree of a large generated program through spans and through
+ * copies of each child list, counting the heap allocations of one walk
+ */
+int main()
+{
+    std::string path = Benchmark::writeInput("span_bench.pr", Benchmark::generateProgram(3000, 20));
+    Parser parser(path);
+    ASTNode* program = parser.parseProgram();
+    printf("%-10s %10s %12s %10s\n", "children", "nodes", "allocations", "ms/walk");
+    report<true>("copied", program);
+    report<false>("spans", program);
+    return 0;
+}
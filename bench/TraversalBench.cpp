@@ -0,0 +1,173 @@
+#include <cstdio>
+#include "Benchmark.h"
+#include "Parser.h"
+#include "IterativeWalker.h"
+#include "StaticVisitor.h"
+#include "Visitor.h"
+
+/**
+ * Counts the nodes of a tree, recursing either through accept and the
+ * virtual visit methods, as visitors did before StaticVisitor, or through
+ * StaticVisitor's switch on the node kind. Both walks share every other line.
+ */
+template <bool IsStatic>
+class NodeCounter final : public Visitor, public StaticVisitor<NodeCounter<IsStatic>>
+{
+public:
+    size_t count = 0;
+
+    void descend(ASTNode* node)
+    {
+        if (!node)
+        {
+            return;
+        }
+        if constexpr (IsStatic)
+        {
+            this->visit(node);
+        }
+        else
+        {
+            node->accept(*this);
+        }
+    }
+
+    void visitIntegerLiteralNode(IntegerLiteralNode*) override { count++; }
+    void visitBooleanLiteralNode(BooleanLiteralNode*) override { count++; }
+    void visitStringLiteralNode(StringLiteralNode*) override { count++; }
+    void visitVariableNode(VariableNode*) override { count++; }
+
+    void visitBinaryOperatorNode(BinaryOperatorNode* node) override
+    {
+        count++;
+        descend(node->left);
+        descend(node->right);
+    }
+
+    void visitCompoundStatementNode(CompoundStatementNode* node) override
+    {
+        count++;
+        for (ASTNode* statement : node->getStatements())
+        {
+            descend(statement);
+        }
+    }
+
+    void visitIfStatementNode(IfStatementNode* node) override
+    {
+        count++;
+        descend(node->getCondition());
+        descend(node->getIfStmtBody());
+        descend(node->getElseBody());
+    }
+
+    void visitVariableDeclarationNode(VariableDeclarationNode* node) override
+    {
+        count++;
+        descend(node->getVarNode());
+        descend(node->getRHS());
+    }
+
+    void visitReturnNode(ReturnNode* node) override
+    {
+        count++;
+        descend(node->toReturn);
+    }
+
+    void visitFunctionCallNode(FunctionCallNode* node) override
+    {
+        count++;
+        for (ASTNode* argument : node->getArguments())
+        {
+            descend(argument);
+        }
+    }
+
+    void visitFunctionDeclarationNode(FunctionDeclarationNode* node) override
+    {
+        count++;
+        for (auto& parameter : node->getParameterList())
+        {
+            descend(parameter.first);
+        }
+        descend(node->getFunctionBody());
+    }
+
+    void visitProgramNode(ProgramNode* node) override
+    {
+        count++;
+        for (ASTNode* unit : node->getProgramUnits())
+        {
+            descend(unit);
+        }
+    }
+
+    void visitWhileNode(WhileNode* node) override
+    {
+        count++;
+        descend(node->getCondition());
+        descend(node->getBody());
+    }
+};
+
+/**
+ * Counts the nodes of a tree on the iterative walker, which the type checker
+ * and the binder run on
+ */
+class IterativeCounter final : public IterativeWalker<IterativeCounter>
+{
+public:
+    size_t count = 0;
+
+    void leaveNode(ASTNode*) { count++; }
+};
+
+template <typename Walk>
+static double timeWalk(Walk walk)
+{
+    const int Rounds = 10;
+    return Benchmark::timeBest(5, [&]()
+    {
+        for (int round = 0; round < Rounds; round++)
+        {
+            walk();
+        }
+    }) / Rounds;
+}
+
+/**
+ * Walks the tree of a large generated program with virtual and with static
+ * dispatch, recursively, and then on the iterative walker
+ */
+int main()
+{
+    std::string path = Benchmark::writeInput("traversal_bench.pr", Benchmark::generateProgram(3000, 20));
+    Parser parser(path);
+    ASTNode* program = parser.parseProgram();
+
+    size_t virtualCount = 0, staticCount = 0, iterativeCount = 0;
+    double virtualSeconds = timeWalk([&]()
+    {
+        NodeCounter<false> counter;
+        counter.descend(program);
+        virtualCount = counter.count;
+    });
+    double staticSeconds = timeWalk([&]()
+    {
+        NodeCounter<true> counter;
+        counter.descend(program);
+        staticCount = counter.count;
+    });
+    double iterativeSeconds = timeWalk([&]()
+    {
+        IterativeCounter counter;
+        counter.walk(program);
+        iterativeCount = counter.count;
+    });
+    printf("%zu nodes\n", staticCount);
+    printf("%-10s %10s %12s\n", "walk", "ms/walk", "ns/node");
+    printf("%-10s %10.2f %12.2f\n", "virtual", virtualSeconds * 1e3, virtualSeconds * 1e9 / virtualCount);
+    printf("%-10s %10.2f %12.2f\n", "static", staticSeconds * 1e3, staticSeconds * 1e9 / staticCount);
+    printf("%-10s %10.2f %12.2f\n", "iterative", iterativeSeconds * 1e3, iterativeSeconds * 1e9 / iterativeCount);
+    return virtualCount == staticCount && staticCount == iterativeCount ? 0 : 1;
+}
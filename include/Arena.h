@@ -0,0 +1,54 @@
+#ifndef ARENA_H
+#define ARENA_H
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+/**
+ * A bump allocator that owns every object created through it. Objects are
+ * carved out of large blocks and destroyed together, in reverse order of
+ * creation, when the arena is released or goes out of scope.
+ */
+class Arena
+{
+private:
+    static const size_t BlockSize = 64 * 1024;
+
+    struct Destructor
+    {
+        void (*destroy)(void* object);
+        void* object;
+    };
+
+    std::vector<std::unique_ptr<char[]>> blocks;
+    std::vector<Destructor> destructors;
+    char* current = nullptr;
+    size_t remaining = 0;
+    void* allocate(size_t size, size_t alignment);
+
+public:
+    Arena() = default;
+    Arena(const Arena&) = delete;
+    Arena& operator=(const Arena&) = delete;
+    ~Arena();
+    void release();
+
+    /**
+     * Constructs a T inside the arena
+     */
+    template <typename T, typename... Args>
+    T* create(Args&&... args)
+    {
+        void* memory = allocate(sizeof(T), alignof(T));
+        T* object = new (memory) T(std::forward<Args>(args)...);
+        if constexpr (!std::is_trivially_destructible_v<T>)
+        {
+            destructors.push_back({ [](void* object) { static_cast<T*>(object)->~T(); }, object });
+        }
+        return object;
+    }
+};
+#endif
@@ -1,10 +1,36 @@
 #ifndef ASTNODE_H
 #define ASTNODE_H
+#include <cstdint>
+
+/**
+ * Identifies the concrete type of a node
+ */
+enum NodeKind : uint8_t
+{
+    IntegerLiteralKind,
+    BooleanLiteralKind,
+    StringLiteralKind,
+    VariableKind,
+    BinaryOperatorKind,
+    CompoundStatementKind,
+    IfStatementKind,
+    VariableDeclarationKind,
+    ReturnKind,
+    FunctionCallKind,
+    FunctionDeclarationKind,
+    ProgramKind,
+    WhileKind
+};
 
 class Visitor;
 class ASTNode
 {
+private:
+    NodeKind kind;
+
 public:
+    ASTNode(NodeKind kind) : kind{ kind } {}
+    NodeKind getKind() { return kind; }
     virtual void accept(Visitor& v) = 0;
 };
 #endif
\ No newline at end of file
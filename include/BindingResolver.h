@@ -0,0 +1,21 @@
+#ifndef BINDING_RESOLVER_H
+#define BINDING_RESOLVER_H
+#include "IterativeWalker.h"
+
+/**
+ * Gives every local variable and parameter a frame slot once the tree is
+ * parsed, and records how many slots each function needs. A variable node is
+ * shared between its declaration and every use, so annotating the
+ * declaration resolves all uses and backends never look a name up.
+ */
+class BindingResolver final : public IterativeWalker<BindingResolver>
+{
+private:
+    int slotCount = 0;
+
+public:
+    void resolve(ASTNode* root);
+    void enterNode(ASTNode* node);
+    void leaveNode(ASTNode* node);
+};
+#endif
@@ -0,0 +1,37 @@
+#ifndef CHAR_SCANNER_H
+#define CHAR_SCANNER_H
+#include <cstddef>
+
+/**
+ * Character-class scanning kernels used by the lexer. Each function returns
+ * the position of the first character at or after `position` that is not in
+ * the scanned class, or `size` if the class runs to the end of the text.
+ * SSE2 and AVX2 versions classify 16 or 32 bytes per step; the widest one the
+ * CPU supports is selected at runtime, with a scalar fallback.
+ */
+namespace CharScanner
+{
+        enum Level
+        {
+            Scalar,
+            SSE2,
+            AVX2
+        };
+
+        /**
+         * Returns the widest kernels the running CPU supports
+         */
+        Level getSupportedLevel();
+
+        /**
+         * Switches to the kernels of the given level, clamped to the supported
+         * one. Meant for benchmarks and tests; it must not race with a scan.
+         */
+        void setLevel(Level level);
+
+        size_t skipWhitespace(const char* text, size_t position, size_t size);
+        size_t skipDigits(const char* text, size_t position, size_t size);
+        size_t skipLetters(const char* text, size_t position, size_t size);
+        size_t findQuote(const char* text, size_t position, size_t size);
+};
+#endif
@@ -3,6 +3,7 @@
 
 #include <vector>
 #include "AstNode.h"
+#include "Span.h"
 
 class CompoundStatementNode : public ASTNode
 {
@@ -11,7 +12,7 @@ private:
 
 public:
     void accept(Visitor& v);
-    std::vector<ASTNode*> getStatements();
+    Span<ASTNode*> getStatements();
     CompoundStatementNode(std::vector<ASTNode*> list);
 
 };
@@ -0,0 +1,79 @@
+#ifndef CONSTANT_PROPAGATOR_H
+#define CONSTANT_PROPAGATOR_H
+#include <cstdint>
+#include <vector>
+#include "ThreeAddressCode.h"
+
+/**
+ * Sparse conditional constant propagation over a function in SSA form, after
+ * Wegman and Zadeck. Starting from the entry, only blocks that some executed
+ * branch can reach are evaluated, and each register is assumed to be
+ * constant until shown otherwise, so values that stay the same around a
+ * loop and branches on constant conditions are both found.
+ *
+ * Registers found to be constant are replaced by immediates and their
+ * definitions removed, and branches with a known outcome become jumps. The
+ * blocks that are no longer reached are left in place.
+ */
+class ConstantPropagator
+{
+private:
+    enum LatticeState : uint8_t
+    {
+        //Not evaluated yet, or only ever seen on paths that are not taken
+        Unknown,
+        Constant,
+        Varying
+    };
+
+    struct LatticeValue
+    {
+        LatticeState state = Unknown;
+        int64_t value = 0;
+    };
+
+    //An instruction that reads a register, or when isPhi is set, a phi whose operand number incoming does
+    struct Use
+    {
+        BlockId block;
+        uint32_t index, incoming;
+        bool isPhi;
+    };
+
+    //An edge into a block, as the index of its entry in the block's predecessors
+    struct Edge
+    {
+        BlockId to;
+        uint32_t predecessorIndex;
+    };
+    static constexpr uint32_t NoPredecessor = UINT32_MAX;
+
+    TACFunction* function = nullptr;
+    std::vector<LatticeValue> values;
+    std::vector<std::vector<Use>> uses;
+    std::vector<uint8_t> isExecutable;
+    //Whether each entry of a block's predecessors has been taken
+    std::vector<std::vector<uint8_t>> isEdgeExecutable;
+    //For each block's successors, the block's index in the successor's predecessors
+    std::vector<std::vector<uint32_t>> predecessorIndices;
+    std::vector<Edge> edgeWorklist;
+    std::vector<VirtualRegister> registerWorklist;
+    uint32_t foldedCount = 0, prunedBranchCount = 0;
+
+    LatticeValue getValue(const TACOperand& operand) const;
+    void setValue(VirtualRegister reg, LatticeValue value);
+    void markEdge(BlockId from, size_t successorIndex);
+    void visitPhi(BlockId block, size_t index, uint32_t incoming);
+    void visitInstruction(BlockId block, size_t index);
+    LatticeValue evaluate(const TACInstruction& instruction) const;
+    static bool fold(TACOpcode op, int64_t left, int64_t right, int64_t& result);
+    void removeEdge(BlockId from, size_t successorIndex);
+    void rewrite();
+
+public:
+    void propagate(TACFunction& function);
+    //Phis and instructions whose value was known, and so were replaced by it
+    uint32_t getFoldedCount() const { return foldedCount; }
+    uint32_t getPrunedBranchCount() const { return prunedBranchCount; }
+};
+#endif
@@ -0,0 +1,31 @@
+#ifndef DEAD_CODE_ELIMINATOR_H
+#define DEAD_CODE_ELIMINATOR_H
+#include <cstdint>
+#include "ThreeAddressCode.h"
+
+/**
+ * Removes code that cannot affect what a function in SSA form does. Blocks
+ * that no path from the entry reaches are dropped first, such as code after
+ * a return or branches pruned by constant propagation. Then, starting from
+ * the instructions that have effects of their own, every register something
+ * live reads is marked live, and the definitions of the rest are removed.
+ * Since locals live in registers by now, this also removes stores to locals
+ * that are never read, including values that only feed themselves around a
+ * loop.
+ */
+class DeadCodeEliminator
+{
+private:
+    uint32_t removedInstructionCount = 0, removedBlockCount = 0;
+
+    void removeUnreachableBlocks(TACFunction& function);
+    void removeDeadInstructions(TACFunction& function);
+    static bool hasSideEffects(const TACInstruction& instruction);
+
+public:
+    void eliminate(TACFunction& function);
+    //Phis count as instructions
+    uint32_t getRemovedInstructionCount() const { return removedInstructionCount; }
+    uint32_t getRemovedBlockCount() const { return removedBlockCount; }
+};
+#endif
@@ -0,0 +1,37 @@
+#ifndef DOMINATOR_TREE_H
+#define DOMINATOR_TREE_H
+#include <cstdint>
+#include <vector>
+#include "ThreeAddressCode.h"
+
+/**
+ * The dominator tree of a function's control flow graph, found with the
+ * iterative algorithm of Cooper, Harvey and Kennedy. Blocks that cannot be
+ * reached from the entry are not part of the tree.
+ */
+class DominatorTree
+{
+private:
+    std::vector<BlockId> immediateDominators;
+    std::vector<std::vector<BlockId>> children;
+    std::vector<BlockId> reversePostorder;
+    //Position of each block in reversePostorder
+    std::vector<uint32_t> orderNumbers;
+    //Each block's span in a preorder walk of the tree, for dominance queries
+    std::vector<uint32_t> preorderStarts, preorderEnds;
+    //Blocks walked through while finding the current block's dominator carry the current mark
+    std::vector<uint32_t> walkMarks;
+    uint32_t walkMark = 0;
+
+    BlockId intersect(BlockId left, BlockId right);
+
+public:
+    DominatorTree(const TACFunction& function);
+    BlockId getImmediateDominator(BlockId block) const;
+    const std::vector<BlockId>& getChildren(BlockId block) const;
+    const std::vector<BlockId>& getReversePostorder() const;
+    bool isReachable(BlockId block) const;
+    bool dominates(BlockId dominator, BlockId block) const;
+    std::vector<std::vector<BlockId>> getDominanceFrontiers(const TACFunction& function) const;
+};
+#endif
@@ -2,16 +2,21 @@
 #define FUNC_CALL_NODE_H
 
 #include "AstNode.h"
-#include <string>
+#include <string_view>
+#include "Interner.h"
+#include "Span.h"
 #include <vector>
 class FunctionCallNode : public ASTNode
 {
 private:
-    std::string identifier;
+    Symbol symbol;
+    std::string_view identifier;
 public:
-    std::string getIdentifier();
+    std::string_view getIdentifier();
+    Symbol getSymbol();
+    Span<ASTNode*> getArguments();
     std::vector<ASTNode*> arguments;
-    FunctionCallNode(std::string identifier, std::vector<ASTNode*> args);
+    FunctionCallNode(Symbol symbol, std::string_view identifier, std::vector<ASTNode*> args);
     void accept(Visitor& v);
 };
 #endif
\ No newline at end of file
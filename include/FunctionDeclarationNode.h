@@ -5,26 +5,29 @@
 #include "Type.h"
 #include "VariableDeclarationNode.h"
 #include <vector>
-#include <string>
+#include <string_view>
 #include "CompoundStatementNode.h"
+#include "Interner.h"
+#include "Span.h"
 class FunctionDeclarationNode : public ASTNode
 {
 private:
     int parameterCount;
 public:
-    FunctionDeclarationNode(Type returnType, std::string functionName);
-    FunctionDeclarationNode(std::string functionName, Type returnType, std::vector<std::pair<VariableDeclarationNode*, Type>> parameterList, ASTNode* functionBody);
+    FunctionDeclarationNode(Type returnType, std::string_view functionName);
+    FunctionDeclarationNode(std::string_view functionName, Type returnType, std::vector<std::pair<VariableDeclarationNode*, Type>> parameterList, ASTNode* functionBody);
     ASTNode* getFunctionBody();
-    std::vector<std::pair<VariableDeclarationNode*, Type>> getParameterList();
+    Span<std::pair<VariableDeclarationNode*, Type>> getParameterList();
     Type getReturnType();
     void accept(Visitor& v);
-    std::string getFunctionName();
+    std::string_view getFunctionName();
     int getParameterCount();
     std::vector<std::pair<VariableDeclarationNode*, Type>> parameterList;
     ASTNode* functionBody;
     Type returnType;
-    std::string functionName;
-    int stackOffset = 0;
+    std::string_view functionName;
+    Symbol functionSymbol = 0;
+    int slotCount = 0;
 
 };
 
@@ -2,36 +2,63 @@
 #define __GENTACVISITOR_H__
 
 
-#include "Visitor.h"
-#include <unordered_map>
-#include <string>
-#include <vector>
-#include "Local.h"
+#include "IterativeWalker.h"
 #include "ThreeAddressCode.h"
 
-class GenTACVisitor : public Visitor
+/**
+ * Builds the three address code of a function. Runs on the iterative walker,
+ * so each node's children have already been generated when its visit method
+ * is called and their results are waiting on the value stack. Expressions
+ * leave their result in value as a register or an immediate; statements
+ * append to the current block and start new blocks wherever control flow
+ * splits or joins, which happens between children in beforeChild.
+ *
+ * A node used as a condition branches to the targets its parent handed down
+ * instead of producing a value, so && and || short-circuit by handing each
+ * side its own targets.
+ */
+class GenTACVisitor final : public IterativeWalker<GenTACVisitor>
 {
 private:
+    /**
+     * The blocks a node needs between entering and leaving it. For a
+     * condition, ifTrue and ifFalse are where it branches to; for an if or a
+     * while they are the body and where a false condition goes. right starts
+     * the right side of && and ||, and is the header of a while. end is where
+     * an if, a while or a && or || used as a value continues.
+     */
+    struct Context
+    {
+        bool isCondition;
+        BlockId ifTrue, ifFalse, right, end;
+        uint32_t slot;
+    };
+    TACFunction function;
+    BlockId currentBlock = 0;
+    //Blocks in the order they were started
+    std::vector<BlockId> layout;
+    TACOperand value;
+    std::vector<TACOperand> values;
+    std::vector<Context> contexts;
+    Context context = {};
+    //Set by a parent just before entering a child that is its condition
+    BlockId conditionTrue = NoBlock, conditionFalse = NoBlock;
 
-
-    int labelCount = 0, scope = 0, endFunctionLabel = 0, tempCount = 0;
-    std::string currentName;
-    std::string variableName;
-    bool isAssignment = false;
-    std::vector<ThreeAddressCode> instructions;
-    int allocatedRegister;
-    int allocateRegister();
-    int allocateLabel();
-    void freeAllRegisters();
-    void loadLocal(int offset);
-    void printLabel(int label);
-    void jumpToLabel(int label);
-    int resolveLocal(std::string identifier);
-    std::vector<Local> locals;
-    std::string invertInstruction(BinaryOperatorNode* node);
-    int currentLabel = 0;
+    void emit(TACOpcode op, VirtualRegister result, TACOperand a, TACOperand b = {});
+    TACOperand emitValue(TACOpcode op, TACOperand a, TACOperand b = {});
+    TACOperand popValue();
+    void setCondition(BlockId ifTrue, BlockId ifFalse);
+    void jumpTo(BlockId target);
+    void branchTo(TACOperand condition, BlockId ifTrue, BlockId ifFalse);
+    void startBlock(BlockId block);
+    static TACOpcode getOpcode(BinaryOperatorNode* node);
+    static bool isShortCircuit(ASTNode* node);
 
 public:
+    TACFunction generate(ASTNode* function);
+    void enterNode(ASTNode* node);
+    bool beforeChild(ASTNode* node, uint32_t index);
+    void leaveNode(ASTNode* node);
     void visitBinaryOperatorNode(BinaryOperatorNode* node);
     void visitIntegerLiteralNode(IntegerLiteralNode* node);
     void visitCompoundStatementNode(CompoundStatementNode* node);
@@ -47,4 +74,4 @@ public:
     void visitStringLiteralNode(StringLiteralNode* node);
 };
 
-#endif // __GENTACVISITOR_H__
\ No newline at end of file
+#endif // __GENTACVISITOR_H__
@@ -0,0 +1,36 @@
+#ifndef INTERNER_H
+#define INTERNER_H
+#include <cstdint>
+#include <memory>
+#include <string_view>
+#include <unordered_map>
+
+using Symbol = uint32_t;
+
+/**
+ * Maps identifier text to dense 32-bit symbols so that later phases can
+ * compare and hash integers instead of strings. The interner stores views,
+ * so the interned text must outlive it (source text or string literals).
+ *
+ * Only one thread may intern at a time, but getText may be called from
+ * another thread for any symbol that has been handed to it, which is what
+ * the pipelined lexer relies on.
+ */
+class Interner
+{
+private:
+    //Chunk k holds 2^(FirstChunkBits + k) texts, enough chunks for every symbol
+    static const unsigned FirstChunkBits = 8;
+    static const unsigned ChunkCount = 33 - FirstChunkBits;
+
+    std::unordered_map<std::string_view, Symbol> symbols;
+    //Texts live in chunks that double in size and never move once allocated
+    std::unique_ptr<std::string_view[]> chunks[ChunkCount];
+    Symbol count = 0;
+    static void locate(Symbol symbol, unsigned& chunk, size_t& index);
+
+public:
+    Symbol intern(std::string_view text);
+    std::string_view getText(Symbol symbol);
+};
+#endif
@@ -0,0 +1,138 @@
+#ifndef ITERATIVE_WALKER_H
+#define ITERATIVE_WALKER_H
+#include <cstdint>
+#include <vector>
+#include "StaticVisitor.h"
+
+/**
+ * Walks a tree in post-order using a heap-allocated work stack instead of
+ * the native call stack, so deeply nested blocks and long operator chains
+ * cost one frame of memory per level rather than several native frames.
+ *
+ * Children are walked first, in source order, then leaveNode is called for
+ * the node, which by default dispatches to the derived class's visitXxxNode
+ * method. Null children are skipped. A derived class may declare its own
+ * enterNode(ASTNode*) or leaveNode(ASTNode*) to hook either end of a node,
+ * and beforeChild(ASTNode*, uint32_t) to act between its children; returning
+ * false from beforeChild skips that child.
+ */
+template <typename Derived>
+class IterativeWalker : public StaticVisitor<Derived>
+{
+private:
+    struct Frame
+    {
+        ASTNode* node;
+        uint32_t nextChild;
+    };
+    std::vector<Frame> workStack;
+
+    static uint32_t getChildCount(ASTNode* node)
+    {
+        switch (node->getKind())
+        {
+            case BinaryOperatorKind:
+            case VariableDeclarationKind:
+            case WhileKind:
+                return 2;
+            case IfStatementKind:
+                return 3;
+            case ReturnKind:
+                return 1;
+            case CompoundStatementKind:
+                return (uint32_t)static_cast<CompoundStatementNode*>(node)->getStatements().size();
+            case ProgramKind:
+                return (uint32_t)static_cast<ProgramNode*>(node)->getProgramUnits().size();
+            case FunctionCallKind:
+                return (uint32_t)static_cast<FunctionCallNode*>(node)->getArguments().size();
+            case FunctionDeclarationKind:
+                return (uint32_t)static_cast<FunctionDeclarationNode*>(node)->getParameterList().size() + 1;
+            default:
+                return 0;
+        }
+    }
+
+    /**
+     * Returns the child at the given position, which may be null
+     */
+    static ASTNode* getChild(ASTNode* node, uint32_t index)
+    {
+        switch (node->getKind())
+        {
+            case BinaryOperatorKind:
+            {
+                auto* binaryOperator = static_cast<BinaryOperatorNode*>(node);
+                return index == 0 ? binaryOperator->left : binaryOperator->right;
+            }
+            case VariableDeclarationKind:
+            {
+                auto* declaration = static_cast<VariableDeclarationNode*>(node);
+                return index == 0 ? declaration->getVarNode() : declaration->getRHS();
+            }
+            case WhileKind:
+            {
+                auto* whileNode = static_cast<WhileNode*>(node);
+                return index == 0 ? whileNode->getCondition() : whileNode->getBody();
+            }
+            case IfStatementKind:
+            {
+                auto* ifStatement = static_cast<IfStatementNode*>(node);
+                return index == 0 ? ifStatement->getCondition() : index == 1 ? ifStatement->getIfStmtBody() : ifStatement->getElseBody();
+            }
+            case ReturnKind:
+                return static_cast<ReturnNode*>(node)->toReturn;
+            case CompoundStatementKind:
+                return static_cast<CompoundStatementNode*>(node)->getStatements()[index];
+            case ProgramKind:
+                return static_cast<ProgramNode*>(node)->getProgramUnits()[index];
+            case FunctionCallKind:
+                return static_cast<FunctionCallNode*>(node)->getArguments()[index];
+            case FunctionDeclarationKind:
+            {
+                auto* function = static_cast<FunctionDeclarationNode*>(node);
+                auto parameters = function->getParameterList();
+                return index < parameters.size() ? parameters[index].first : function->getFunctionBody();
+            }
+            default:
+                return nullptr;
+        }
+    }
+
+public:
+    void enterNode(ASTNode*) {}
+    bool beforeChild(ASTNode*, uint32_t) { return true; }
+    void leaveNode(ASTNode* node) { this->visit(node); }
+
+    /**
+     * Walks the tree rooted at the given node
+     */
+    void walk(ASTNode* root)
+    {
+        Derived& self = static_cast<Derived&>(*this);
+        if (!root)
+        {
+            return;
+        }
+        self.enterNode(root);
+        workStack.push_back({ root, 0 });
+        while (!workStack.empty())
+        {
+            Frame& frame = workStack.back();
+            if (frame.nextChild < getChildCount(frame.node))
+            {
+                uint32_t index = frame.nextChild++;
+                ASTNode* node = frame.node, * child = getChild(node, index);
+                if (child && self.beforeChild(node, index))
+                {
+                    self.enterNode(child);
+                    workStack.push_back({ child, 0 });
+                }
+                continue;
+            }
+            ASTNode* node = frame.node;
+            workStack.pop_back();
+            self.leaveNode(node);
+        }
+    }
+};
+#endif
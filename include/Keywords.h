@@ -0,0 +1,153 @@
+#ifndef KEYWORDS_H
+#define KEYWORDS_H
+#include <cstdint>
+#include <string_view>
+#include "SyntaxToken.h"
+
+/**
+ * Perfect hash over the language keywords. The multiplier is found at compile
+ * time so that every keyword lands in its own slot, which lets the lexer
+ * classify an identifier with one hash and at most one comparison.
+ */
+namespace Keywords
+{
+    struct Keyword
+    {
+        std::string_view text;
+        SyntaxType syntaxType;
+    };
+
+    constexpr Keyword list[] = {
+        { "bool", BoolKeywordToken },
+        { "double", DoubleKeywordToken },
+        { "else", ElseToken },
+        { "false", FalseKeywordToken },
+        { "if", IfToken },
+        { "int", IntKeywordToken },
+        { "print", PrintToken },
+        { "return", ReturnKeyword },
+        { "true", TrueKeywordToken },
+        { "var", VarKeywordToken },
+        { "while", WhileKeywordToken }
+    };
+
+    constexpr unsigned TableSize = 32;
+
+    /**
+     * Mixes the first character, last character and length of a lexeme
+     */
+    constexpr unsigned hash(std::string_view text, unsigned seed)
+    {
+        unsigned first = (unsigned char)text[0], last = (unsigned char)text[text.size() - 1];
+        return (first * seed + last + (unsigned)text.size()) & (TableSize - 1);
+    }
+
+    constexpr bool isPerfect(unsigned seed)
+    {
+        bool used[TableSize]{};
+        for (const auto& keyword : list)
+        {
+            unsigned slot = hash(keyword.text, seed);
+            if (used[slot])
+            {
+                return false;
+            }
+            used[slot] = true;
+        }
+        return true;
+    }
+
+    constexpr unsigned findSeed()
+    {
+        for (unsigned seed = 1; seed < 4096; seed++)
+        {
+            if (isPerfect(seed))
+            {
+                return seed;
+            }
+        }
+        return 0;
+    }
+
+    constexpr unsigned seed = findSeed();
+    static_assert(seed != 0, "No perfect hash found for the keyword set");
+
+    /**
+     * Packs a lexeme of 2 to 8 characters into one integer, from its first and
+     * last 2 or 4 characters. The two reads overlap for the shorter lengths,
+     * so two lexemes of the same length pack alike only if they are equal.
+     * The shifts compile to plain loads.
+     */
+    constexpr uint64_t load16(const char* text)
+    {
+        return (uint64_t)(unsigned char)text[0] | (uint64_t)(unsigned char)text[1] << 8;
+    }
+
+    constexpr uint64_t load32(const char* text)
+    {
+        return load16(text) | load16(text + 2) << 16;
+    }
+
+    constexpr uint64_t pack(std::string_view text)
+    {
+        const char* last = text.data() + text.size();
+        if (text.size() >= 4)
+        {
+            return load32(text.data()) | load32(last - 4) << 32;
+        }
+        return load16(text.data()) | load16(last - 2) << 32;
+    }
+
+    struct Slot
+    {
+        uint64_t packed;
+        uint32_t size;
+        SyntaxType syntaxType;
+    };
+
+    struct Table
+    {
+        Slot slots[TableSize];
+    };
+
+    constexpr Table buildTable()
+    {
+        Table table{};
+        for (const auto& keyword : list)
+        {
+            table.slots[hash(keyword.text, seed)] = { pack(keyword.text), (uint32_t)keyword.text.size(), keyword.syntaxType };
+        }
+        return table;
+    }
+
+    constexpr Table table = buildTable();
+
+    constexpr bool hasShortKeywords()
+    {
+        for (const auto& keyword : list)
+        {
+            if (keyword.text.size() < 2 || keyword.text.size() > 8)
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+    static_assert(hasShortKeywords(), "Every keyword must be 2 to 8 characters long to be packed");
+
+    /**
+     * Returns the keyword type for a lexeme, or IdentifierToken if the lexeme
+     * is not a keyword. The lexeme must not be empty. Empty slots have size 0,
+     * so a lexeme is only packed, and compared, once its length matches.
+     */
+    inline SyntaxType lookup(std::string_view lexeme)
+    {
+        const Slot& slot = table.slots[hash(lexeme, seed)];
+        if (slot.size != lexeme.size())
+        {
+            return IdentifierToken;
+        }
+        return pack(lexeme) == slot.packed ? slot.syntaxType : IdentifierToken;
+    }
+};
+#endif
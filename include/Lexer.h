@@ -1,21 +1,28 @@
 #ifndef LEXER_H
 #define LEXER_H
 #include <string>
+#include <string_view>
 #include "SyntaxToken.h"
-#include <fstream>
+#include "SourceFile.h"
+#include "Interner.h"
 class Lexer
 {
 private:
-    int position = 0;
-    std::string text;
-    std::ifstream file;
+    size_t position = 0;
+    SourceFile file;
+    std::string_view text;
+    Interner& interner;
     char getCurrentChar();
     void skipWhitespace();
+    SyntaxToken fail(uint32_t start);
 
 public:
     bool hasReachedEOF();
     void advance();
     SyntaxToken lex();
-    Lexer(std::string text);
+    std::string_view getText(SyntaxToken token);
+    std::string getErrorMessage(SyntaxToken token);
+    bool hasSource();
+    Lexer(std::string text, Interner& interner);
 };
 #endif
\ No newline at end of file
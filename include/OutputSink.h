@@ -0,0 +1,107 @@
+#ifndef OUTPUT_SINK_H
+#define OUTPUT_SINK_H
+#include <charconv>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+/**
+ * Destination for emitted code. Writes are copied into a window of memory
+ * that the sink hands out, so the common case is a bounds check and a
+ * memcpy; the sink only gets involved when the window is full. Numbers are
+ * formatted with to_chars rather than through iostreams.
+ */
+class OutputSink
+{
+protected:
+    char* cursor = nullptr;
+    char* limit = nullptr;
+
+    //Makes room for at least size more bytes between cursor and limit
+    virtual void reserve(size_t size) = 0;
+
+public:
+    OutputSink() = default;
+    OutputSink(const OutputSink&) = delete;
+    OutputSink& operator=(const OutputSink&) = delete;
+    virtual ~OutputSink() = default;
+    virtual void flush() {}
+
+    void write(const char* data, size_t size)
+    {
+        if ((size_t)(limit - cursor) < size)
+        {
+            reserve(size);
+        }
+        memcpy(cursor, data, size);
+        cursor += size;
+    }
+
+    OutputSink& operator<<(std::string_view text)
+    {
+        write(text.data(), text.size());
+        return *this;
+    }
+
+    OutputSink& operator<<(char c)
+    {
+        write(&c, 1);
+        return *this;
+    }
+
+    template <typename T, typename = std::enable_if_t<std::is_integral_v<T> && !std::is_same_v<T, char> && !std::is_same_v<T, bool>>>
+    OutputSink& operator<<(T value)
+    {
+        char digits[24];
+        auto result = std::to_chars(digits, digits + sizeof(digits), value);
+        write(digits, result.ptr - digits);
+        return *this;
+    }
+};
+
+/**
+ * Collects the output in memory
+ */
+class BufferSink : public OutputSink
+{
+private:
+    std::vector<char> buffer;
+
+protected:
+    void reserve(size_t size) override;
+
+public:
+    std::string_view getText() const;
+};
+
+/**
+ * Writes to a file in large blocks. If the file cannot be opened or written,
+ * the error is recorded and the rest of the output is discarded, so the
+ * caller checks getError once it has flushed.
+ */
+class FileSink : public OutputSink
+{
+private:
+    static const size_t BlockSize = 1 << 20;
+    std::vector<char> buffer;
+    std::string path;
+    std::string error;
+#ifdef _WIN32
+    void* fileHandle = nullptr;
+#else
+    int fd = -1;
+#endif
+
+protected:
+    void reserve(size_t size) override;
+
+public:
+    FileSink(const std::string& path);
+    ~FileSink();
+    void flush() override;
+    //Empty unless opening or writing the file failed
+    const std::string& getError() const { return error; }
+};
+#endif
@@ -4,25 +4,31 @@
 #include <string>
 #include "SyntaxToken.h"
 #include "Lexer.h"
+#include "TokenBuffer.h"
+#include "Interner.h"
+#include "Arena.h"
 #include "AstNode.h"
 #include "BinaryOperatorNode.h"
 #include <unordered_map>
-#include <stack>
 #include <string>
-#include "ScopeTreeNode.h"
+#include "ScopedSymbolTable.h"
 #include "FunctionDeclarationNode.h"
 #include "Type.h"
+#include "StringPool.h"
 class Parser
 {
 private:
-    std::vector<SyntaxToken> tokens;
+    std::string path;
+    Arena arena;
+    Interner interner;
+    Symbol printfSymbol;
     Lexer lexer;
-    int scope = 0;
-    int position = 0;
-    int localOffset = 0;
-    int getOperatorPrecedence(SyntaxType op);
-    bool isBinaryOperator(SyntaxType syntaxType);
-    std::stack<ScopeTreeNode*> scopeTreeStack;
+    TokenBuffer tokens;
+    struct OperatorTable;
+    static constexpr int getOperatorPrecedence(SyntaxType op);
+    static constexpr bool isBinaryOperator(SyntaxType syntaxType);
+    static constexpr bool isRightAssociative(SyntaxType op);
+    ScopedSymbolTable symbols;
 
     SyntaxToken peek(int offset);
     SyntaxToken getCurrentToken();
@@ -31,22 +37,30 @@ private:
     BinaryOperatorType getBinaryOperatorType(SyntaxType op);
 
     ASTNode* parsePrimary();
-    ASTNode* parseExpression(int minimumPrecedence);
+    ASTNode* parseExpression();
     ASTNode* parseCompoundStatement();
     ASTNode* parseStatement();
-    ASTNode* parseIfStatement();
     ASTNode* parseVariableDeclarationStatement();
     ASTNode* parseReturnStatement();
     ASTNode* parseFunctionDeclaration();
     ASTNode* parseExpressionStatement();
-    ASTNode* parseWhileStatement();
     ASTNode* parseAssignmentStatement();
-    ASTNode* resolve(std::string identifier, ScopeTreeNode* node);
-    bool isRightAssociative(SyntaxType op);
-    std::unordered_map<std::string, int> stringLiterals;
+    StringPool strings;
+
+    //Thrown to abandon the parse at the first error
+    struct SyntaxError
+    {
+        std::string message;
+    };
+    std::vector<std::string> errors;
+    [[noreturn]] void fail(const std::string& message);
+
 public:
-    Parser(std::string text);
+    Parser(std::string text, bool isPipelined = false);
+    //The returned tree is owned by the parser and freed along with it. On an
+    //error, null is returned and the error is available from getErrors.
     ASTNode* parseProgram();
+    const std::vector<std::string>& getErrors();
     void printTokens();
 };
 #endif
\ No newline at end of file
@@ -0,0 +1,23 @@
+#ifndef PASS_STATISTICS_H
+#define PASS_STATISTICS_H
+#include <atomic>
+#include <cstdint>
+
+class OutputSink;
+
+/**
+ * What each optimization pass did, summed over every function compiled.
+ * Functions are optimized in parallel, so the counters are atomic.
+ */
+struct PassStatistics
+{
+    //Constant propagation
+    std::atomic<uint64_t> foldedInstructions{ 0 }, prunedBranches{ 0 };
+    //Dead code elimination
+    std::atomic<uint64_t> removedInstructions{ 0 }, removedBlocks{ 0 };
+    //Global value numbering
+    std::atomic<uint64_t> eliminatedComputations{ 0 };
+
+    void print(OutputSink& out) const;
+};
+#endif
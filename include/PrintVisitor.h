@@ -1,10 +1,11 @@
 #ifndef PRINT_VISITOR_H
 #define PRINT_VISITOR_H
 #include "Visitor.h"
+#include "StaticVisitor.h"
 #include "Type.h"
 #include <stack>
 #include <string>
-class PrintVisitor : public Visitor
+class PrintVisitor final : public Visitor, public StaticVisitor<PrintVisitor>
 {
 private:
     int indentation = 0;
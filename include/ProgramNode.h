@@ -2,19 +2,21 @@
 #define PROGRAM_NODE_H
 
 #include <vector>
-#include <unordered_map>
 #include "AstNode.h"
+#include "Span.h"
+#include "StringPool.h"
 
 class ProgramNode : public ASTNode
 {
 private:
     std::vector<ASTNode*> programUnits;
+    StringPool strings;
 
 public:
     void accept(Visitor& v);
-    std::vector<ASTNode*> getProgramUnits();
-    ProgramNode(std::vector<ASTNode*> list);
-    std::unordered_map<std::string, int> stringLiterals;
+    Span<ASTNode*> getProgramUnits();
+    const StringPool& getStrings();
+    ProgramNode(std::vector<ASTNode*> list, StringPool strings);
 };
 
 #endif
\ No newline at end of file
@@ -0,0 +1,47 @@
+#ifndef REGISTER_ALLOCATOR_H
+#define REGISTER_ALLOCATOR_H
+#include <cstdint>
+#include <vector>
+#include "ThreeAddressCode.h"
+
+/**
+ * Assigns every virtual register of a function a machine register, or a
+ * spill slot when none is free, by linear scan over live intervals. Blocks
+ * are numbered in layout order, and an interval runs from the first to the
+ * last position where its register is live.
+ *
+ * Machine registers are numbered from 0. The first preservedCount of them
+ * survive calls, and only those are given to values live across a call.
+ */
+class RegisterAllocator
+{
+private:
+    struct Interval
+    {
+        uint32_t start, end;
+    };
+
+    int registerCount, preservedCount;
+    std::vector<Interval> intervals;
+    std::vector<int> assignments;
+    std::vector<uint32_t> spillSlots;
+    std::vector<uint32_t> callPositions;
+    uint32_t spillSlotCount = 0;
+    uint32_t usedRegisters = 0;
+
+    void computeIntervals(const TACFunction& function);
+    void extend(VirtualRegister reg, uint32_t position);
+    bool isLiveAcrossCall(const Interval& interval) const;
+    void spill(VirtualRegister reg);
+
+public:
+    static constexpr int Spilled = -1;
+
+    RegisterAllocator(int registerCount, int preservedCount);
+    void allocate(const TACFunction& function);
+    int getRegister(VirtualRegister reg) const;
+    uint32_t getSpillSlot(VirtualRegister reg) const;
+    uint32_t getSpillSlotCount() const;
+    uint32_t getUsedRegisters() const;
+};
+#endif
@@ -0,0 +1,19 @@
+#ifndef SSA_BUILDER_H
+#define SSA_BUILDER_H
+#include "ThreeAddressCode.h"
+
+/**
+ * Puts a function into static single assignment form. Every local slot is
+ * promoted to registers: phis are placed on the iterated dominance frontier
+ * of the blocks that store to the slot, then a walk down the dominator tree
+ * replaces each load with the value that reaches it, and the loads and
+ * stores are removed. A slot read before anything is stored to it reads 0.
+ *
+ * Blocks that cannot be reached from the entry are left as they are.
+ */
+class SSABuilder
+{
+public:
+    void build(TACFunction& function);
+};
+#endif
@@ -0,0 +1,23 @@
+#ifndef SSA_DESTRUCTOR_H
+#define SSA_DESTRUCTOR_H
+#include <utility>
+#include <vector>
+#include "ThreeAddressCode.h"
+
+/**
+ * Takes a function out of static single assignment form before it is
+ * lowered. Each phi becomes a copy at the end of every predecessor. An edge
+ * from a block with several successors gets a block of its own to hold its
+ * copies, so they do not run on the block's other paths.
+ */
+class SSADestructor
+{
+private:
+    using Copy = std::pair<VirtualRegister, TACOperand>;
+
+    static void insertCopies(TACFunction& function, BlockId block, std::vector<Copy>& copies);
+
+public:
+    void destruct(TACFunction& function);
+};
+#endif
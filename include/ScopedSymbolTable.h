@@ -0,0 +1,41 @@
+#ifndef SCOPED_SYMBOL_TABLE_H
+#define SCOPED_SYMBOL_TABLE_H
+#include <cstdint>
+#include <vector>
+#include "AstNode.h"
+#include "Interner.h"
+
+/**
+ * A single symbol table for every scope. Each symbol maps straight to its
+ * innermost visible binding, and each binding remembers the one it shadows,
+ * so resolving a name is one probe no matter how deeply scopes are nested.
+ * Popping a scope unwinds the bindings declared since the matching push.
+ */
+class ScopedSymbolTable
+{
+private:
+    static constexpr uint32_t NoBinding = UINT32_MAX;
+
+    struct Binding
+    {
+        Symbol symbol;
+        uint32_t depth;
+        uint32_t shadowed;
+        ASTNode* node;
+    };
+
+    //Bindings in declaration order, so the innermost scope is always at the end
+    std::vector<Binding> bindings;
+    //Innermost binding of each symbol, indexed by symbol
+    std::vector<uint32_t> visible;
+    //Size of bindings when each open scope was pushed
+    std::vector<uint32_t> scopeStarts;
+
+public:
+    void pushScope();
+    void popScope();
+    void declare(Symbol symbol, ASTNode* node);
+    ASTNode* lookup(Symbol symbol) const;
+    bool isDeclaredInCurrentScope(Symbol symbol) const;
+};
+#endif
@@ -0,0 +1,34 @@
+#ifndef SOURCE_FILE_H
+#define SOURCE_FILE_H
+#include <string>
+#include <string_view>
+
+/**
+ * A read-only view of a source file. The file is memory-mapped where the
+ * platform allows it so that the lexer can hand out views into the mapping
+ * instead of copying each lexeme.
+ */
+class SourceFile
+{
+private:
+    const char* data = nullptr;
+    size_t size = 0;
+    bool isMapped = false;
+    bool isOpened = true;
+    std::string buffer;
+#ifdef _WIN32
+    void* fileHandle = nullptr;
+    void* mappingHandle = nullptr;
+#endif
+    bool map(const std::string& path);
+    void unmap();
+
+public:
+    SourceFile(const std::string& path);
+    SourceFile(const SourceFile&) = delete;
+    SourceFile& operator=(const SourceFile&) = delete;
+    ~SourceFile();
+    std::string_view getText() const;
+    bool isOpen() const;
+};
+#endif
@@ -0,0 +1,25 @@
+#ifndef SPAN_H
+#define SPAN_H
+#include <cstddef>
+
+/**
+ * A non-owning view of a contiguous sequence, used to hand out a node's
+ * children without copying the container that holds them
+ */
+template <typename T>
+class Span
+{
+private:
+    T* first = nullptr;
+    T* last = nullptr;
+
+public:
+    Span() = default;
+    Span(T* first, size_t count) : first{ first }, last{ first + count } {}
+    T* begin() const { return first; }
+    T* end() const { return last; }
+    size_t size() const { return last - first; }
+    bool empty() const { return first == last; }
+    T& operator[](size_t index) const { return first[index]; }
+};
+#endif
@@ -0,0 +1,76 @@
+#ifndef STATIC_VISITOR_H
+#define STATIC_VISITOR_H
+
+#include "AstNode.h"
+#include "BinaryOperatorNode.h"
+#include "BooleanLiteralNode.h"
+#include "CompoundStatementNode.h"
+#include "FunctionCallNode.h"
+#include "FunctionDeclarationNode.h"
+#include "IfStatementNode.h"
+#include "IntegerLiteralNode.h"
+#include "ProgramNode.h"
+#include "ReturnNode.h"
+#include "StringLiteralNode.h"
+#include "VariableDeclarationNode.h"
+#include "VariableNode.h"
+#include "WhileNode.h"
+
+/**
+ * Dispatches on a node's kind tag instead of going through accept and a
+ * virtual visit method. Derived visitors call visit(node) to recurse; when
+ * the derived class is final its visit methods are called directly and can
+ * be inlined.
+ */
+template <typename Derived>
+class StaticVisitor
+{
+public:
+    void visit(ASTNode* node)
+    {
+        Derived& self = static_cast<Derived&>(*this);
+        switch (node->getKind())
+        {
+            case IntegerLiteralKind:
+                self.visitIntegerLiteralNode(static_cast<IntegerLiteralNode*>(node));
+                break;
+            case BooleanLiteralKind:
+                self.visitBooleanLiteralNode(static_cast<BooleanLiteralNode*>(node));
+                break;
+            case StringLiteralKind:
+                self.visitStringLiteralNode(static_cast<StringLiteralNode*>(node));
+                break;
+            case VariableKind:
+                self.visitVariableNode(static_cast<VariableNode*>(node));
+                break;
+            case BinaryOperatorKind:
+                self.visitBinaryOperatorNode(static_cast<BinaryOperatorNode*>(node));
+                break;
+            case CompoundStatementKind:
+                self.visitCompoundStatementNode(static_cast<CompoundStatementNode*>(node));
+                break;
+            case IfStatementKind:
+                self.visitIfStatementNode(static_cast<IfStatementNode*>(node));
+                break;
+            case VariableDeclarationKind:
+                self.visitVariableDeclarationNode(static_cast<VariableDeclarationNode*>(node));
+                break;
+            case ReturnKind:
+                self.visitReturnNode(static_cast<ReturnNode*>(node));
+                break;
+            case FunctionCallKind:
+                self.visitFunctionCallNode(static_cast<FunctionCallNode*>(node));
+                break;
+            case FunctionDeclarationKind:
+                self.visitFunctionDeclarationNode(static_cast<FunctionDeclarationNode*>(node));
+                break;
+            case ProgramKind:
+                self.visitProgramNode(static_cast<ProgramNode*>(node));
+                break;
+            case WhileKind:
+                self.visitWhileNode(static_cast<WhileNode*>(node));
+                break;
+        }
+    }
+};
+#endif
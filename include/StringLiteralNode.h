@@ -2,12 +2,15 @@
 #define STRING_LITERAL_NODE_H
 
 #include "AstNode.h"
+#include <cstdint>
 #include <string>
 class StringLiteralNode : public ASTNode
 {
 public:
     std::string value;
-    StringLiteralNode(std::string value);
+    //Index of the literal in the compilation's StringPool
+    uint32_t poolIndex;
+    StringLiteralNode(std::string value, uint32_t poolIndex);
     void accept(Visitor& v);
 };
 #endif
\ No newline at end of file
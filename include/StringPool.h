@@ -0,0 +1,27 @@
+#ifndef STRING_POOL_H
+#define STRING_POOL_H
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * The string literals of one compilation. Each distinct literal is stored
+ * once, in the order it was first seen, and is emitted under its own label
+ * namespace (.LC0, .LC1, ...) so that it never collides with code labels.
+ */
+class StringPool
+{
+private:
+    std::unordered_map<std::string, uint32_t> indices;
+    //Map keys do not move as the map grows, so they can be listed in order
+    std::vector<const std::string*> strings;
+
+public:
+    uint32_t add(std::string_view text);
+    uint32_t size() const;
+    const std::string& getText(uint32_t index) const;
+    static std::string getLabel(uint32_t index);
+};
+#endif
@@ -1,7 +1,8 @@
 #ifndef SYNTAXTOKEN_H
 #define SYNTAXTOKEN_H
-#include <string>
-enum SyntaxType
+#include <cstdint>
+#include "Interner.h"
+enum SyntaxType : uint8_t
 {
     AddToken,
     MinusToken,
@@ -40,18 +41,27 @@ enum SyntaxType
     ReturnKeyword,
     WhileKeywordToken,
     CommaToken,
-    DoubleQuoteToken
+    DoubleQuoteToken,
+    //Produced in place of a token that cannot be lexed; its value is the offset
+    ErrorToken
 };
 
+/**
+ * A token is just its kind and a 32-bit value: the interned symbol for
+ * identifiers, and the offset of its first character in the source for
+ * everything else. The text is recovered on demand through Lexer::getText.
+ */
 class SyntaxToken
 {
 private:
-    std::string text;
-    SyntaxType syntaxType;
+    uint32_t value = 0;
+    SyntaxType syntaxType = EOFToken;
 public:
-    std::string getText();
+    uint32_t getOffset();
+    Symbol getSymbol();
+    uint32_t getValue();
     SyntaxType getSyntaxType();
-    SyntaxToken(SyntaxType syntaxType, std::string text);
+    SyntaxToken(SyntaxType syntaxType, uint32_t value);
     SyntaxToken();
 };
 
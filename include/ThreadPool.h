@@ -0,0 +1,47 @@
+#ifndef THREAD_POOL_H
+#define THREAD_POOL_H
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * A fixed set of worker threads that run indexed loops. The thread calling
+ * parallelFor claims iterations alongside the workers and only waits for the
+ * ones already running elsewhere, so a task may itself call parallelFor on
+ * the same pool without deadlocking.
+ */
+class ThreadPool
+{
+private:
+    struct Job
+    {
+        const std::function<void(size_t)>* task;
+        size_t count;
+        std::atomic<size_t> next{ 0 };
+        std::atomic<size_t> done{ 0 };
+    };
+
+    std::vector<std::thread> workers;
+    std::deque<std::shared_ptr<Job>> jobs;
+    std::mutex mutex;
+    std::condition_variable hasWork, hasFinished;
+    bool isStopping = false;
+
+    void runWorker();
+    void runIterations(const std::shared_ptr<Job>& job);
+    void removeJob(const std::shared_ptr<Job>& job);
+
+public:
+    explicit ThreadPool(unsigned threadCount);
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+    ~ThreadPool();
+    void parallelFor(size_t count, const std::function<void(size_t)>& task);
+    static unsigned getDefaultThreadCount();
+};
+#endif
@@ -1,16 +1,118 @@
 #ifndef __THREEADDRESSCODE_H__
 #define __THREEADDRESSCODE_H__
-#include <string>
-struct ThreeAddressCode
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+class OutputSink;
+
+using VirtualRegister = uint32_t;
+using BlockId = uint32_t;
+
+static constexpr VirtualRegister NoRegister = UINT32_MAX;
+static constexpr BlockId NoBlock = UINT32_MAX;
+
+enum TACOpcode : uint8_t
+{
+    MoveOp,                 //result = a
+    AddOp,                  //result = a + b
+    SubtractOp,             //result = a - b
+    MultiplyOp,             //result = a * b
+    DivideOp,               //result = a / b
+    LessThanOp,             //result = a < b, as 0 or 1
+    LessThanOrEqualToOp,    //result = a <= b
+    GreaterThanOp,          //result = a > b
+    GreaterThanOrEqualToOp, //result = a >= b
+    EqualsOp,               //result = a == b
+    ParameterOp,            //result = parameter number a
+    LoadOp,                 //result = local slot a
+    StoreOp,                //local slot a = b
+    ArgumentOp,             //argument number a of the next call = b
+    CallOp,                 //result = call of callee number a with b arguments
+    JumpOp,                 //continue at the block's only successor
+    BranchOp,               //continue at the first successor if a is nonzero, otherwise the second
+    ReturnOp                //return a
+};
+
+enum OperandKind : uint8_t
 {
-    std::string op, arg1, arg2, result;
-
-    ThreeAddressCode(std::string op, std::string arg1, std::string arg2, std::string result)
-    {
-        this->op = op;
-        this->arg1 = arg1;
-        this->arg2 = arg2;
-        this->result = result;
-    }
+    NoOperand,
+    RegisterOperand,
+    ImmediateOperand,
+    //The address of the string with this index in the program's string pool
+    StringOperand
+};
+
+struct TACOperand
+{
+    OperandKind kind = NoOperand;
+    int64_t value = 0;
+
+    static TACOperand makeRegister(VirtualRegister reg) { return { RegisterOperand, reg }; }
+    static TACOperand makeImmediate(int64_t value) { return { ImmediateOperand, value }; }
+    static TACOperand makeString(uint32_t index) { return { StringOperand, index }; }
+    bool isRegister() const { return kind == RegisterOperand; }
+    bool isImmediate() const { return kind == ImmediateOperand; }
+    VirtualRegister getRegister() const { return (VirtualRegister)value; }
+    bool operator==(const TACOperand& other) const { return kind == other.kind && value == other.value; }
+    bool operator!=(const TACOperand& other) const { return !(*this == other); }
+};
+
+struct TACInstruction
+{
+    TACOpcode op;
+    VirtualRegister result = NoRegister;
+    TACOperand a, b;
+
+    bool isTerminator() const { return op >= JumpOp; }
+};
+
+/**
+ * Picks the value of incoming[i] when control arrives from the block's
+ * predecessors[i]
+ */
+struct TACPhi
+{
+    VirtualRegister result;
+    std::vector<TACOperand> incoming;
+};
+
+/**
+ * A straight run of instructions that ends in exactly one terminator. A
+ * branch goes to successors[0] when its condition holds and successors[1]
+ * otherwise; a jump goes to successors[0]; a return has no successors. The
+ * phis all take effect on entry, before the first instruction.
+ */
+struct BasicBlock
+{
+    std::vector<TACPhi> phis;
+    std::vector<TACInstruction> instructions;
+    std::vector<BlockId> successors, predecessors;
+};
+
+/**
+ * The three address code of one function as a control flow graph. Block 0
+ * is the entry, and blocks are laid out in index order.
+ *
+ * As generated, every virtual register is defined once and values that
+ * change, such as locals, live in numbered slots that are read with LoadOp
+ * and written with StoreOp. SSABuilder turns the slots into registers joined
+ * by phis, and SSADestructor turns the phis back into copies, after which a
+ * register may be defined more than once.
+ */
+struct TACFunction
+{
+    std::string_view name;
+    uint32_t parameterCount = 0, slotCount = 0, registerCount = 0;
+    std::vector<BasicBlock> blocks;
+    //The names that CallOp's callee numbers refer to
+    std::vector<std::string_view> callees;
+
+    VirtualRegister newRegister() { return registerCount++; }
+    BlockId newBlock();
+    void addEdge(BlockId from, BlockId to);
+    std::vector<std::vector<uint32_t>> getPredecessorIndices() const;
+    void reorderBlocks(const std::vector<BlockId>& order);
+    void print(OutputSink& out) const;
 };
-#endif // __THREEADDRESSCODE_H__
\ No newline at end of file
+#endif // __THREEADDRESSCODE_H__
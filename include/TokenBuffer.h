@@ -0,0 +1,47 @@
+#ifndef TOKEN_BUFFER_H
+#define TOKEN_BUFFER_H
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <thread>
+#include "SyntaxToken.h"
+#include "Lexer.h"
+#include "TokenQueue.h"
+
+/**
+ * A bounded lookahead window over the token stream. Tokens are pulled from
+ * the lexer only when the parser asks for them and are stored as a struct of
+ * arrays in a ring: one byte for the syntax type and the 32-bit token value.
+ *
+ * In pipelined mode the lexer runs on its own thread and the window is
+ * refilled from a TokenQueue instead of calling the lexer directly.
+ */
+class TokenBuffer
+{
+public:
+    //The parser never looks past the current token, so a tiny ring suffices
+    static const int Capacity = 2;
+
+private:
+    static_assert((Capacity & (Capacity - 1)) == 0, "Capacity must be a power of two");
+    Lexer& lexer;
+    SyntaxType types[Capacity];
+    uint32_t values[Capacity];
+    unsigned head = 0, count = 0;
+
+    std::unique_ptr<TokenQueue> queue;
+    std::thread lexerThread;
+    std::atomic<bool> isStopping{ false };
+    //EOF or an error token, after which the lexer thread has stopped
+    bool hasReceivedLastToken = false;
+    SyntaxToken lastToken;
+    SyntaxToken pull();
+    void runLexer();
+
+public:
+    TokenBuffer(Lexer& lexer, bool isPipelined);
+    ~TokenBuffer();
+    SyntaxToken peek(int offset);
+    void advance();
+};
+#endif
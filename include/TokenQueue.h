@@ -0,0 +1,34 @@
+#ifndef TOKEN_QUEUE_H
+#define TOKEN_QUEUE_H
+#include <atomic>
+#include <cstdint>
+#include "SyntaxToken.h"
+
+/**
+ * A lock-free single-producer/single-consumer ring of tokens, used to hand
+ * tokens from a lexer thread to the parser. Each side caches the other
+ * side's index and only reloads it when the ring looks full or empty.
+ */
+class TokenQueue
+{
+public:
+    static const unsigned Capacity = 4096;
+
+private:
+    static_assert((Capacity & (Capacity - 1)) == 0, "Capacity must be a power of two");
+    SyntaxType types[Capacity];
+    uint32_t values[Capacity];
+
+    //Written by the consumer
+    alignas(64) std::atomic<unsigned> head{ 0 };
+    unsigned cachedTail = 0;
+
+    //Written by the producer
+    alignas(64) std::atomic<unsigned> tail{ 0 };
+    unsigned cachedHead = 0;
+
+public:
+    bool tryPush(SyntaxToken token);
+    bool tryPop(SyntaxToken& token);
+};
+#endif
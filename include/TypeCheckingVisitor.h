@@ -1,14 +1,44 @@
 #ifndef TCV_H
 #define TCV_H
-#include "Visitor.h"
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+#include "IterativeWalker.h"
+#include "Interner.h"
+#include "ThreadPool.h"
 #include "Type.h"
-class TypeCheckingVisitor : public Visitor
+
+/**
+ * Checks operand, initializer and return types. Runs on the iterative walker,
+ * so each node's children have already been checked when its visit method is
+ * called and their types are waiting on the type stack.
+ *
+ * A program is checked in two passes: the return type of every function is
+ * collected first, then each function is checked by its own visitor, on the
+ * pool if one is given. Errors are collected rather than ending the process
+ * and are reported in source order.
+ */
+class TypeCheckingVisitor final : public IterativeWalker<TypeCheckingVisitor>
 {
 private:
-    Type type, functionType;
-    bool isTypeInference = false;
+    ThreadPool* pool = nullptr;
+    const std::unordered_map<Symbol, Type>* signatures = nullptr;
+    Type type = IntegerPrimitive, functionType = IntegerPrimitive;
+    std::string_view functionName;
+    std::vector<Type> types;
+    std::vector<std::string> errors;
+    Type popType();
+    void reportError(const std::string& message);
+    void checkProgram(ProgramNode* node);
+    TypeCheckingVisitor(const std::unordered_map<Symbol, Type>* signatures);
 
 public:
+    TypeCheckingVisitor(ThreadPool* pool = nullptr);
+    bool check(ASTNode* root);
+    const std::vector<std::string>& getErrors();
+    void enterNode(ASTNode* node);
+    void leaveNode(ASTNode* node);
     void visitBinaryOperatorNode(BinaryOperatorNode* node);
     void visitIntegerLiteralNode(IntegerLiteralNode* node);
     void visitCompoundStatementNode(CompoundStatementNode* node);
@@ -27,4 +57,4 @@ public:
     Type getType();
 };
 
-#endif
\ No newline at end of file
+#endif
@@ -0,0 +1,53 @@
+#ifndef VALUE_NUMBERER_H
+#define VALUE_NUMBERER_H
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+#include "ThreeAddressCode.h"
+
+/**
+ * Dominator-based global value numbering over a function in SSA form, after
+ * Briggs, Cooper and Simpson. A walk down the dominator tree keeps a table
+ * of the computations made in the blocks above, so a computation that was
+ * already made in a dominating block, or earlier in its own, is replaced by
+ * the register that holds its result. Copies and phis whose operands are
+ * all the same value are replaced by that value.
+ *
+ * Only reachable blocks are visited, so unreachable ones should be removed
+ * first.
+ */
+class ValueNumberer
+{
+private:
+    struct Expression
+    {
+        TACOpcode op;
+        TACOperand a, b;
+
+        bool operator==(const Expression& other) const { return op == other.op && a == other.a && b == other.b; }
+    };
+
+    struct ExpressionHash
+    {
+        size_t operator()(const Expression& expression) const;
+    };
+
+    std::vector<TACOperand> replacements;
+    //For each block's successors, the block's index in the successor's predecessors
+    std::vector<std::vector<uint32_t>> predecessorIndices;
+    std::unordered_map<Expression, VirtualRegister, ExpressionHash> available;
+    //The expressions added to the table on the way down, so each block can take its own out again
+    std::vector<Expression> addedExpressions;
+    uint32_t eliminatedCount = 0;
+
+    TACOperand getReplacement(const TACOperand& operand) const;
+    void numberBlock(TACFunction& function, BlockId id);
+    static bool isPure(TACOpcode op);
+    static bool isCommutative(TACOpcode op);
+
+public:
+    void number(TACFunction& function);
+    //Phis and copies count as computations
+    uint32_t getEliminatedCount() const { return eliminatedCount; }
+};
+#endif
@@ -2,7 +2,7 @@
 #define VDN_H
 
 #include "AstNode.h"
-#include <string>
+#include <string_view>
 #include "Type.h"
 #include "VariableNode.h"
 class VariableDeclarationNode : public ASTNode
@@ -10,17 +10,20 @@ class VariableDeclarationNode : public ASTNode
 
 private:
     ASTNode* rhs;
-    std::string identifier;
+    Symbol symbol;
+    std::string_view identifier;
     ASTNode* varNode;
     Type type;
 
 public:
     ASTNode* getRHS();
     Type getType();
-    std::string getIdentifier();
+    std::string_view getIdentifier();
+    Symbol getSymbol();
     ASTNode* getVarNode();
+    int getSlot();
 
-    VariableDeclarationNode(ASTNode* varNode, ASTNode* rhs, std::string identifier);
+    VariableDeclarationNode(ASTNode* varNode, ASTNode* rhs, Symbol symbol, std::string_view identifier);
     void accept(Visitor& v);
 };
 
@@ -3,19 +3,26 @@
 
 #include "AstNode.h"
 #include "Type.h"
+#include "Interner.h"
+#include <string_view>
 
 class VariableNode : public ASTNode
 {
 private:
-    std::string identifier;
+    Symbol symbol;
+    std::string_view identifier;
     Type type;
     bool isLocal;
+    int slot = -1;
 
 public:
     Type getType();
-    std::string getIdentifier();
+    std::string_view getIdentifier();
+    Symbol getSymbol();
     void setType(Type type);
-    VariableNode(Type type, std::string identifer, bool isLocal);
+    int getSlot();
+    void setBinding(int slot);
+    VariableNode(Type type, Symbol symbol, std::string_view identifier, bool isLocal);
     void accept(Visitor& v);
 };
 #endif
\ No newline at end of file
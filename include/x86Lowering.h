@@ -0,0 +1,53 @@
+#ifndef X86_LOWERING_H
+#define X86_LOWERING_H
+
+#include "OutputSink.h"
+#include "RegisterAllocator.h"
+#include "StringPool.h"
+#include "ThreeAddressCode.h"
+#include <string>
+#include <string_view>
+#include <vector>
+
+/**
+ * Lowers the three address code of a function to x86-64 assembly. Virtual
+ * registers live wherever the register allocator put them; %rax and %r11
+ * are never allocated and serve as scratch registers.
+ */
+class x86Lowering
+{
+private:
+    OutputSink& out;
+    //Labels are numbered per function and qualified by the function's index
+    int functionIndex;
+    const TACFunction* function = nullptr;
+    RegisterAllocator allocator;
+    std::vector<uint32_t> useCounts;
+    uint32_t slotCount = 0;
+    std::vector<std::string> errors;
+
+    bool checkCallingConvention(const TACFunction& function);
+    bool isInMemory(const TACOperand& operand) const;
+    bool isInRegister(const TACOperand& operand, std::string_view machineRegister) const;
+    static bool isLargeImmediate(const TACOperand& operand);
+    void writeOperand(const TACOperand& operand);
+    void writeSlot(uint32_t slot);
+    void writeLabel(BlockId block);
+    void moveToRegister(const TACOperand& source, std::string_view machineRegister);
+    void moveFromRegister(std::string_view machineRegister, VirtualRegister result);
+    void moveToResult(const TACOperand& source, VirtualRegister result);
+    void lowerInstruction(BlockId block, size_t index);
+    void lowerArithmetic(const TACInstruction& instruction);
+    void lowerComparison(const TACInstruction& instruction);
+    void lowerBranch(BlockId block, const TACInstruction& instruction, const TACInstruction* comparison);
+    void jumpTo(BlockId from, BlockId to);
+    TACOpcode compare(const TACInstruction& comparison);
+    static std::string_view getConditionCode(TACOpcode op, bool isInverted);
+
+public:
+    x86Lowering(OutputSink& out, int functionIndex);
+    static void writeHeader(OutputSink& out, const StringPool& strings);
+    bool lower(const TACFunction& function);
+    const std::vector<std::string>& getErrors();
+};
+#endif
@@ -0,0 +1,45 @@
+#include "../include/Arena.h"
+#include <cstdint>
+
+Arena::~Arena()
+{
+    release();
+}
+
+/**
+ * Destroys every object in the arena and frees its memory
+ */
+void Arena::release()
+{
+    while (!destructors.empty())
+    {
+        auto& destructor = destructors.back();
+        destructor.destroy(destructor.object);
+        destructors.pop_back();
+    }
+    blocks.clear();
+    current = nullptr;
+    remaining = 0;
+}
+
+/**
+ * Returns suitably aligned uninitialized memory, starting a new block when
+ * the current one is exhausted
+ */
+void* Arena::allocate(size_t size, size_t alignment)
+{
+    size_t padding = (alignment - (reinterpret_cast<uintptr_t>(current) & (alignment - 1))) & (alignment - 1);
+    if (padding + size > remaining)
+    {
+        //Oversized objects get a block of their own
+        size_t blockSize = size + alignment > BlockSize ? size + alignment : BlockSize;
+        blocks.push_back(std::make_unique<char[]>(blockSize));
+        current = blocks.back().get();
+        remaining = blockSize;
+        padding = (alignment - (reinterpret_cast<uintptr_t>(current) & (alignment - 1))) & (alignment - 1);
+    }
+    void* memory = current + padding;
+    current += padding + size;
+    remaining -= padding + size;
+    return memory;
+}
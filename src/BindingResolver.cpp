@@ -0,0 +1,37 @@
+#include "../include/BindingResolver.h"
+
+void BindingResolver::resolve(ASTNode* root)
+{
+    walk(root);
+}
+
+/**
+ * Slots are handed out in declaration order, parameters first, and are not
+ * reused when a block ends
+ */
+void BindingResolver::enterNode(ASTNode* node)
+{
+    switch (node->getKind())
+    {
+        case FunctionDeclarationKind:
+            slotCount = 0;
+            break;
+        case VariableDeclarationKind:
+        {
+            auto variable = static_cast<VariableNode*>(static_cast<VariableDeclarationNode*>(node)->getVarNode());
+            variable->setBinding(slotCount);
+            slotCount++;
+            break;
+        }
+        default:
+            break;
+    }
+}
+
+void BindingResolver::leaveNode(ASTNode* node)
+{
+    if (node->getKind() == FunctionDeclarationKind)
+    {
+        static_cast<FunctionDeclarationNode*>(node)->slotCount = slotCount;
+    }
+}
@@ -1,6 +1,6 @@
 #include "../include/BooleanLiteralNode.h"
 #include "../include/Visitor.h"
-BooleanLiteralNode::BooleanLiteralNode(bool value) : value{ value } {}
+BooleanLiteralNode::BooleanLiteralNode(bool value) : ASTNode(BooleanLiteralKind), value{ value } {}
 void BooleanLiteralNode::accept(Visitor& v)
 {
     v.visitBooleanLiteralNode(this);
@@ -0,0 +1,248 @@
+#include "../include/CharScanner.h"
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define CHAR_SCANNER_X86
+#include <immintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#define TARGET_AVX2
+#else
+#define TARGET_AVX2 __attribute__((target("avx2")))
+#endif
+#endif
+
+enum CharClass
+{
+    Whitespace,
+    Digit,
+    Letter,
+    NotQuote
+};
+
+using ScanFunction = size_t(*)(const char* text, size_t position, size_t size);
+
+/**
+ * The set of kernels picked for the running CPU
+ */
+struct Kernels
+{
+    ScanFunction skipWhitespace, skipDigits, skipLetters, findQuote;
+};
+
+/**
+ * Returns true if the character belongs to the class. Matches the "C" locale
+ * behaviour of isspace, isdigit and isalpha.
+ */
+template <CharClass C>
+static inline bool isInClass(unsigned char c)
+{
+    switch (C)
+    {
+        case Whitespace:
+            return c == ' ' || (unsigned char)(c - '\t') <= '\r' - '\t';
+        case Digit:
+            return (unsigned char)(c - '0') <= 9;
+        case Letter:
+            return (unsigned char)((c | 0x20) - 'a') <= 'z' - 'a';
+        case NotQuote:
+            return c != '"';
+    }
+    return false;
+}
+
+template <CharClass C>
+static size_t scanScalar(const char* text, size_t position, size_t size)
+{
+    while (position < size && isInClass<C>(text[position]))
+    {
+        position++;
+    }
+    return position;
+}
+
+#ifdef CHAR_SCANNER_X86
+static inline unsigned countTrailingZeros(unsigned mask)
+{
+#ifdef _MSC_VER
+    unsigned long index;
+    _BitScanForward(&index, mask);
+    return index;
+#else
+    return __builtin_ctz(mask);
+#endif
+}
+
+/**
+ * Unsigned range check: lo <= x <= hi for every byte
+ */
+static inline __m128i inRange(__m128i x, char lo, char hi)
+{
+    __m128i shifted = _mm_sub_epi8(x, _mm_set1_epi8(lo));
+    return _mm_cmpeq_epi8(_mm_min_epu8(shifted, _mm_set1_epi8(hi - lo)), shifted);
+}
+
+template <CharClass C>
+static inline __m128i classify(__m128i x)
+{
+    switch (C)
+    {
+        case Whitespace:
+            return _mm_or_si128(_mm_cmpeq_epi8(x, _mm_set1_epi8(' ')), inRange(x, '\t', '\r'));
+        case Digit:
+            return inRange(x, '0', '9');
+        case Letter:
+            return inRange(_mm_or_si128(x, _mm_set1_epi8(0x20)), 'a', 'z');
+        case NotQuote:
+            return _mm_xor_si128(_mm_cmpeq_epi8(x, _mm_set1_epi8('"')), _mm_set1_epi8(-1));
+    }
+    return _mm_setzero_si128();
+}
+
+template <CharClass C>
+static size_t scanSSE2(const char* text, size_t position, size_t size)
+{
+    while (position + 16 <= size)
+    {
+        __m128i x = _mm_loadu_si128((const __m128i*)(text + position));
+        unsigned mask = ~(unsigned)_mm_movemask_epi8(classify<C>(x)) & 0xFFFF;
+        if (mask)
+        {
+            return position + countTrailingZeros(mask);
+        }
+        position += 16;
+    }
+    return scanScalar<C>(text, position, size);
+}
+
+TARGET_AVX2 static inline __m256i inRange(__m256i x, char lo, char hi)
+{
+    __m256i shifted = _mm256_sub_epi8(x, _mm256_set1_epi8(lo));
+    return _mm256_cmpeq_epi8(_mm256_min_epu8(shifted, _mm256_set1_epi8(hi - lo)), shifted);
+}
+
+template <CharClass C>
+TARGET_AVX2 static inline __m256i classify(__m256i x)
+{
+    switch (C)
+    {
+        case Whitespace:
+            return _mm256_or_si256(_mm256_cmpeq_epi8(x, _mm256_set1_epi8(' ')), inRange(x, '\t', '\r'));
+        case Digit:
+            return inRange(x, '0', '9');
+        case Letter:
+            return inRange(_mm256_or_si256(x, _mm256_set1_epi8(0x20)), 'a', 'z');
+        case NotQuote:
+            return _mm256_xor_si256(_mm256_cmpeq_epi8(x, _mm256_set1_epi8('"')), _mm256_set1_epi8(-1));
+    }
+    return _mm256_setzero_si256();
+}
+
+template <CharClass C>
+TARGET_AVX2 static size_t scanAVX2(const char* text, size_t position, size_t size)
+{
+    while (position + 32 <= size)
+    {
+        __m256i x = _mm256_loadu_si256((const __m256i*)(text + position));
+        unsigned mask = ~(unsigned)_mm256_movemask_epi8(classify<C>(x));
+        if (mask)
+        {
+            return position + countTrailingZeros(mask);
+        }
+        position += 32;
+    }
+    return scanSSE2<C>(text, position, size);
+}
+
+static bool hasAVX2()
+{
+#ifdef _MSC_VER
+    int info[4];
+    __cpuid(info, 0);
+    if (info[0] < 7)
+    {
+        return false;
+    }
+    __cpuid(info, 1);
+    bool osSavesYmm = (info[2] & (1 << 27)) && (_xgetbv(0) & 6) == 6;
+    __cpuidex(info, 7, 0);
+    return osSavesYmm && (info[1] & (1 << 5));
+#else
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2");
+#endif
+}
+
+static bool hasSSE2()
+{
+#if defined(__x86_64__) || defined(_M_X64)
+    return true;
+#elif defined(_MSC_VER)
+    int info[4];
+    __cpuid(info, 1);
+    return info[3] & (1 << 26);
+#else
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("sse2");
+#endif
+}
+#endif
+
+CharScanner::Level CharScanner::getSupportedLevel()
+{
+#ifdef CHAR_SCANNER_X86
+    static const Level level = hasAVX2() ? AVX2 : hasSSE2() ? SSE2 : Scalar;
+    return level;
+#else
+    return Scalar;
+#endif
+}
+
+/**
+ * Returns the kernels of a level the running CPU supports
+ */
+static Kernels selectKernels(CharScanner::Level level)
+{
+#ifdef CHAR_SCANNER_X86
+    switch (level)
+    {
+        case CharScanner::AVX2:
+            return { scanAVX2<Whitespace>, scanAVX2<Digit>, scanAVX2<Letter>, scanAVX2<NotQuote> };
+        case CharScanner::SSE2:
+            return { scanSSE2<Whitespace>, scanSSE2<Digit>, scanSSE2<Letter>, scanSSE2<NotQuote> };
+        case CharScanner::Scalar:
+            break;
+    }
+#endif
+    return { scanScalar<Whitespace>, scanScalar<Digit>, scanScalar<Letter>, scanScalar<NotQuote> };
+}
+
+static Kernels& getKernels()
+{
+    static Kernels kernels = selectKernels(CharScanner::getSupportedLevel());
+    return kernels;
+}
+
+void CharScanner::setLevel(Level level)
+{
+    getKernels() = selectKernels(level < getSupportedLevel() ? level : getSupportedLevel());
+}
+
+size_t CharScanner::skipWhitespace(const char* text, size_t position, size_t size)
+{
+    return getKernels().skipWhitespace(text, position, size);
+}
+
+size_t CharScanner::skipDigits(const char* text, size_t position, size_t size)
+{
+    return getKernels().skipDigits(text, position, size);
+}
+
+size_t CharScanner::skipLetters(const char* text, size_t position, size_t size)
+{
+    return getKernels().skipLetters(text, position, size);
+}
+
+size_t CharScanner::findQuote(const char* text, size_t position, size_t size)
+{
+    return getKernels().findQuote(text, position, size);
+}
@@ -1,18 +1,19 @@
 #include "../include/CompoundStatementNode.h"
 #include "../include/Visitor.h"
+#include <utility>
 
 /**
  * Returns a list of statements contained within the block
  */
-std::vector<ASTNode*> CompoundStatementNode::getStatements()
+Span<ASTNode*> CompoundStatementNode::getStatements()
 {
-    return statements;
+    return Span<ASTNode*>(statements.data(), statements.size());
 }
 
 /**
  * Constructor
  */
-CompoundStatementNode::CompoundStatementNode(std::vector<ASTNode*> list) : statements{ list } {};
+CompoundStatementNode::CompoundStatementNode(std::vector<ASTNode*> list) : ASTNode(CompoundStatementKind), statements{ std::move(list) } {};
 
 void CompoundStatementNode::accept(Visitor& v)
 {
@@ -0,0 +1,357 @@
+#include "../include/ConstantPropagator.h"
+#include <algorithm>
+
+void ConstantPropagator::propagate(TACFunction& function)
+{
+    this->function = &function;
+    size_t blockCount = function.blocks.size();
+    values.assign(function.registerCount, {});
+    uses.assign(function.registerCount, {});
+    isExecutable.assign(blockCount, 0);
+    isEdgeExecutable.assign(blockCount, {});
+    predecessorIndices = function.getPredecessorIndices();
+    edgeWorklist.clear();
+    registerWorklist.clear();
+
+    for (BlockId id = 0; id < blockCount; id++)
+    {
+        const BasicBlock& block = function.blocks[id];
+        isEdgeExecutable[id].assign(block.predecessors.size(), 0);
+        for (uint32_t i = 0; i < block.phis.size(); i++)
+        {
+            const std::vector<TACOperand>& incoming = block.phis[i].incoming;
+            for (uint32_t k = 0; k < incoming.size(); k++)
+            {
+                if (incoming[k].isRegister())
+                {
+                    uses[incoming[k].getRegister()].push_back({ id, i, k, true });
+                }
+            }
+        }
+        for (uint32_t i = 0; i < block.instructions.size(); i++)
+        {
+            for (const TACOperand* operand : { &block.instructions[i].a, &block.instructions[i].b })
+            {
+                if (operand->isRegister())
+                {
+                    uses[operand->getRegister()].push_back({ id, i, 0, false });
+                }
+            }
+        }
+    }
+
+    //The entry is reached by calling the function rather than by an edge
+    edgeWorklist.push_back({ 0, NoPredecessor });
+    while (!edgeWorklist.empty() || !registerWorklist.empty())
+    {
+        while (!edgeWorklist.empty())
+        {
+            Edge edge = edgeWorklist.back();
+            BlockId to = edge.to;
+            edgeWorklist.pop_back();
+            const BasicBlock& block = function.blocks[to];
+            bool isFirstVisit = !isExecutable[to];
+            isExecutable[to] = 1;
+
+            //A new edge only brings in its own phi operands, unless the block has not been evaluated at all
+            if (edge.predecessorIndex != NoPredecessor)
+            {
+                isEdgeExecutable[to][edge.predecessorIndex] = 1;
+                for (size_t i = 0; i < block.phis.size(); i++)
+                {
+                    visitPhi(to, i, edge.predecessorIndex);
+                }
+            }
+            for (size_t i = 0; isFirstVisit && i < block.instructions.size(); i++)
+            {
+                visitInstruction(to, i);
+            }
+        }
+        while (!registerWorklist.empty() && edgeWorklist.empty())
+        {
+            VirtualRegister reg = registerWorklist.back();
+            registerWorklist.pop_back();
+            for (const Use& use : uses[reg])
+            {
+                if (!isExecutable[use.block])
+                {
+                    continue;
+                }
+                if (use.isPhi)
+                {
+                    visitPhi(use.block, use.index, use.incoming);
+                }
+                else
+                {
+                    visitInstruction(use.block, use.index);
+                }
+            }
+        }
+    }
+
+    rewrite();
+}
+
+ConstantPropagator::LatticeValue ConstantPropagator::getValue(const TACOperand& operand) const
+{
+    switch (operand.kind)
+    {
+        case RegisterOperand:
+            return values[operand.getRegister()];
+        case ImmediateOperand:
+            return { Constant, operand.value };
+        default:
+            //A string's address is only known once the program is linked
+            return { Varying, 0 };
+    }
+}
+
+/**
+ * Lowers the register's value and queues its uses if it changed. Values
+ * only ever go from Unknown to Constant to Varying, which is what makes the
+ * propagation finish.
+ */
+void ConstantPropagator::setValue(VirtualRegister reg, LatticeValue value)
+{
+    LatticeValue& current = values[reg];
+    if (value.state == Unknown || current.state == Varying || (current.state == Constant && value.state == Constant && current.value == value.value))
+    {
+        return;
+    }
+    current = current.state == Constant ? LatticeValue{ Varying, 0 } : value;
+    registerWorklist.push_back(reg);
+}
+
+/**
+ * Queues one of a block's outgoing edges to be taken, if it has not been
+ * already
+ */
+void ConstantPropagator::markEdge(BlockId from, size_t successorIndex)
+{
+    BlockId to = function->blocks[from].successors[successorIndex];
+    uint32_t k = predecessorIndices[from][successorIndex];
+    if (!isEdgeExecutable[to][k])
+    {
+        edgeWorklist.push_back({ to, k });
+    }
+}
+
+/**
+ * A phi is the meet of the values arriving along the edges taken so far.
+ * Since setValue only ever lowers a value, the operands can be met with it
+ * one at a time, as their edge is taken or their value changes, rather than
+ * all of them each time.
+ */
+void ConstantPropagator::visitPhi(BlockId block, size_t index, uint32_t incoming)
+{
+    if (isEdgeExecutable[block][incoming])
+    {
+        const TACPhi& phi = function->blocks[block].phis[index];
+        setValue(phi.result, getValue(phi.incoming[incoming]));
+    }
+}
+
+void ConstantPropagator::visitInstruction(BlockId block, size_t index)
+{
+    const BasicBlock& basicBlock = function->blocks[block];
+    const TACInstruction& instruction = basicBlock.instructions[index];
+    switch (instruction.op)
+    {
+        case JumpOp:
+            markEdge(block, 0);
+            break;
+        case BranchOp:
+        {
+            LatticeValue condition = getValue(instruction.a);
+            if (condition.state == Varying || (condition.state == Constant && condition.value != 0))
+            {
+                markEdge(block, 0);
+            }
+            if (condition.state == Varying || (condition.state == Constant && condition.value == 0))
+            {
+                markEdge(block, 1);
+            }
+            break;
+        }
+        default:
+            if (instruction.result != NoRegister)
+            {
+                setValue(instruction.result, evaluate(instruction));
+            }
+            break;
+    }
+}
+
+ConstantPropagator::LatticeValue ConstantPropagator::evaluate(const TACInstruction& instruction) const
+{
+    switch (instruction.op)
+    {
+        case MoveOp:
+            return getValue(instruction.a);
+        case AddOp:
+        case SubtractOp:
+        case MultiplyOp:
+        case DivideOp:
+        case LessThanOp:
+        case LessThanOrEqualToOp:
+        case GreaterThanOp:
+        case GreaterThanOrEqualToOp:
+        case EqualsOp:
+        {
+            LatticeValue left = getValue(instruction.a), right = getValue(instruction.b);
+            if (left.state == Varying || right.state == Varying)
+            {
+                return { Varying, 0 };
+            }
+            if (left.state == Unknown || right.state == Unknown)
+            {
+                return {};
+            }
+            int64_t result;
+            if (!fold(instruction.op, left.value, right.value, result))
+            {
+                return { Varying, 0 };
+            }
+            return { Constant, result };
+        }
+        default:
+            //Parameters and calls are only known at run time
+            return { Varying, 0 };
+    }
+}
+
+/**
+ * Computes an operation on constants the way the generated code would.
+ * Arithmetic wraps around at 64 bits. Returns false for a division that
+ * would trap, which is left for run time.
+ */
+bool ConstantPropagator::fold(TACOpcode op, int64_t left, int64_t right, int64_t& result)
+{
+    switch (op)
+    {
+        case AddOp:
+            result = (int64_t)((uint64_t)left + (uint64_t)right);
+            return true;
+        case SubtractOp:
+            result = (int64_t)((uint64_t)left - (uint64_t)right);
+            return true;
+        case MultiplyOp:
+            result = (int64_t)((uint64_t)left * (uint64_t)right);
+            return true;
+        case DivideOp:
+            if (right == 0 || (left == INT64_MIN && right == -1))
+            {
+                return false;
+            }
+            result = left / right;
+            return true;
+        case LessThanOp:
+            result = left < right;
+            return true;
+        case LessThanOrEqualToOp:
+            result = left <= right;
+            return true;
+        case GreaterThanOp:
+            result = left > right;
+            return true;
+        case GreaterThanOrEqualToOp:
+            result = left >= right;
+            return true;
+        case EqualsOp:
+            result = left == right;
+            return true;
+        default:
+            return false;
+    }
+}
+
+/**
+ * Removes one of a block's outgoing edges. The block it led to only has the
+ * entry in its predecessors cleared, and rewrite drops the cleared entries
+ * and their phi operands afterwards, so that a join losing many edges is
+ * compacted once rather than once per edge.
+ */
+void ConstantPropagator::removeEdge(BlockId from, size_t successorIndex)
+{
+    std::vector<BlockId>& successors = function->blocks[from].successors;
+    function->blocks[successors[successorIndex]].predecessors[predecessorIndices[from][successorIndex]] = NoBlock;
+    successors.erase(successors.begin() + successorIndex);
+}
+
+/**
+ * Turns branches with a known outcome into jumps, then replaces every
+ * constant register with its value and drops its definition
+ */
+void ConstantPropagator::rewrite()
+{
+    std::vector<BasicBlock>& blocks = function->blocks;
+    for (BlockId id = 0; id < blocks.size(); id++)
+    {
+        TACInstruction& terminator = blocks[id].instructions.back();
+        if (!isExecutable[id] || terminator.op != BranchOp)
+        {
+            continue;
+        }
+        LatticeValue condition = getValue(terminator.a);
+        if (condition.state == Constant)
+        {
+            removeEdge(id, condition.value != 0 ? 1 : 0);
+            terminator.op = JumpOp;
+            terminator.a = {};
+            terminator.b = {};
+            terminator.result = NoRegister;
+            prunedBranchCount++;
+        }
+    }
+    for (BasicBlock& block : blocks)
+    {
+        size_t kept = 0;
+        for (size_t k = 0; k < block.predecessors.size(); k++)
+        {
+            if (block.predecessors[k] == NoBlock)
+            {
+                continue;
+            }
+            block.predecessors[kept] = block.predecessors[k];
+            for (TACPhi& phi : block.phis)
+            {
+                phi.incoming[kept] = phi.incoming[k];
+            }
+            kept++;
+        }
+        block.predecessors.resize(kept);
+        for (TACPhi& phi : block.phis)
+        {
+            phi.incoming.resize(kept);
+        }
+    }
+
+    auto replace = [&](TACOperand& operand)
+    {
+        if (operand.isRegister() && values[operand.getRegister()].state == Constant)
+        {
+            operand = TACOperand::makeImmediate(values[operand.getRegister()].value);
+        }
+    };
+    auto isConstant = [&](VirtualRegister reg)
+    {
+        return reg != NoRegister && values[reg].state == Constant;
+    };
+    for (BasicBlock& block : blocks)
+    {
+        size_t phiCount = block.phis.size(), instructionCount = block.instructions.size();
+        block.phis.erase(std::remove_if(block.phis.begin(), block.phis.end(), [&](const TACPhi& phi) { return isConstant(phi.result); }), block.phis.end());
+        for (TACPhi& phi : block.phis)
+        {
+            std::for_each(phi.incoming.begin(), phi.incoming.end(), replace);
+        }
+        block.instructions.erase(std::remove_if(block.instructions.begin(), block.instructions.end(),
+            [&](const TACInstruction& instruction) { return isConstant(instruction.result); }), block.instructions.end());
+        foldedCount += (uint32_t)(phiCount - block.phis.size() + instructionCount - block.instructions.size());
+        for (TACInstruction& instruction : block.instructions)
+        {
+            replace(instruction.a);
+            replace(instruction.b);
+        }
+    }
+}
@@ -0,0 +1,151 @@
+#include "../include/DeadCodeEliminator.h"
+#include <algorithm>
+#include <vector>
+
+void DeadCodeEliminator::eliminate(TACFunction& function)
+{
+    removeUnreachableBlocks(function);
+    removeDeadInstructions(function);
+}
+
+/**
+ * Drops the blocks that cannot be reached from the entry, along with the
+ * phi operands for edges that leave them. The remaining blocks keep their
+ * order.
+ */
+void DeadCodeEliminator::removeUnreachableBlocks(TACFunction& function)
+{
+    size_t blockCount = function.blocks.size();
+    std::vector<uint8_t> isReachable(blockCount, 0);
+    std::vector<BlockId> worklist{ 0 };
+    isReachable[0] = 1;
+    while (!worklist.empty())
+    {
+        BlockId id = worklist.back();
+        worklist.pop_back();
+        for (BlockId successor : function.blocks[id].successors)
+        {
+            if (!isReachable[successor])
+            {
+                isReachable[successor] = 1;
+                worklist.push_back(successor);
+            }
+        }
+    }
+
+    std::vector<BlockId> order;
+    for (BlockId id = 0; id < blockCount; id++)
+    {
+        BasicBlock& block = function.blocks[id];
+        if (!isReachable[id])
+        {
+            removedBlockCount++;
+            removedInstructionCount += (uint32_t)(block.phis.size() + block.instructions.size());
+            continue;
+        }
+        order.push_back(id);
+
+        //reorderBlocks drops the same predecessors, keeping the order of the rest
+        for (TACPhi& phi : block.phis)
+        {
+            size_t kept = 0;
+            for (size_t k = 0; k < block.predecessors.size(); k++)
+            {
+                if (isReachable[block.predecessors[k]])
+                {
+                    phi.incoming[kept++] = phi.incoming[k];
+                }
+            }
+            phi.incoming.resize(kept);
+        }
+    }
+    if (order.size() != blockCount)
+    {
+        function.reorderBlocks(order);
+    }
+}
+
+/**
+ * Marks every register that an instruction with side effects depends on,
+ * directly or through other registers, then removes the phis and
+ * instructions that define the unmarked ones
+ */
+void DeadCodeEliminator::removeDeadInstructions(TACFunction& function)
+{
+    std::vector<uint8_t> isLive(function.registerCount, 0);
+    //The phi or instruction that defines each register
+    std::vector<const TACPhi*> phiDefinitions(function.registerCount, nullptr);
+    std::vector<const TACInstruction*> definitions(function.registerCount, nullptr);
+    std::vector<VirtualRegister> worklist;
+    auto markLive = [&](const TACOperand& operand)
+    {
+        if (operand.isRegister() && !isLive[operand.getRegister()])
+        {
+            isLive[operand.getRegister()] = 1;
+            worklist.push_back(operand.getRegister());
+        }
+    };
+
+    for (const BasicBlock& block : function.blocks)
+    {
+        for (const TACPhi& phi : block.phis)
+        {
+            phiDefinitions[phi.result] = &phi;
+        }
+        for (const TACInstruction& instruction : block.instructions)
+        {
+            if (instruction.result != NoRegister)
+            {
+                definitions[instruction.result] = &instruction;
+            }
+            if (hasSideEffects(instruction))
+            {
+                markLive(instruction.a);
+                markLive(instruction.b);
+            }
+        }
+    }
+
+    while (!worklist.empty())
+    {
+        VirtualRegister reg = worklist.back();
+        worklist.pop_back();
+        if (phiDefinitions[reg])
+        {
+            std::for_each(phiDefinitions[reg]->incoming.begin(), phiDefinitions[reg]->incoming.end(), markLive);
+        }
+        else if (definitions[reg])
+        {
+            markLive(definitions[reg]->a);
+            markLive(definitions[reg]->b);
+        }
+    }
+
+    for (BasicBlock& block : function.blocks)
+    {
+        size_t phiCount = block.phis.size(), instructionCount = block.instructions.size();
+        block.phis.erase(std::remove_if(block.phis.begin(), block.phis.end(), [&](const TACPhi& phi) { return !isLive[phi.result]; }), block.phis.end());
+        block.instructions.erase(std::remove_if(block.instructions.begin(), block.instructions.end(),
+            [&](const TACInstruction& instruction) { return !hasSideEffects(instruction) && !isLive[instruction.result]; }), block.instructions.end());
+        removedInstructionCount += (uint32_t)(phiCount - block.phis.size() + instructionCount - block.instructions.size());
+    }
+}
+
+/**
+ * Returns whether the instruction has to run even if nothing reads its
+ * result
+ */
+bool DeadCodeEliminator::hasSideEffects(const TACInstruction& instruction)
+{
+    switch (instruction.op)
+    {
+        case CallOp:
+            return true;
+        case DivideOp:
+            //Dividing by zero, or the smallest value by -1, traps
+            return !instruction.b.isImmediate() || instruction.b.value == 0 || instruction.b.value == -1;
+        default:
+            //Stores, arguments and terminators have no result
+            return instruction.result == NoRegister;
+    }
+}
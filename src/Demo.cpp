@@ -1,34 +1,299 @@
+#include <atomic>
+#include <cstdlib>
 #include <iostream>
 #include <string>
-#include <unordered_map>
 #include <vector>
 
 #include "../include/AstNode.h"
+#include "../include/ConstantPropagator.h"
+#include "../include/DeadCodeEliminator.h"
+#include "../include/GenTACVisitor.h"
+#include "../include/OutputSink.h"
 #include "../include/Parser.h"
-
-#include "../include/PrintVisitor.h"
-#include "../include/x86Visitor.h"
+#include "../include/PassStatistics.h"
+#include "../include/SSABuilder.h"
+#include "../include/SSADestructor.h"
+#include "../include/ThreadPool.h"
 #include "../include/TypeCheckingVisitor.h"
-#include "../include/GenTACVisitor.h"
+#include "../include/ValueNumberer.h"
+#include "../include/x86Lowering.h"
 
 
-void compile(std::string inFile, std::string outFile);
+/**
+ * Driver flags that change how every file is compiled
+ */
+struct Options
+{
+    bool isPipelined = false;
+    bool isDumpingTAC = false;
+};
+
+bool compile(std::string inFile, std::string outFile, const Options& options, ThreadPool& pool, PassStatistics& statistics);
+bool compileBatch(const std::vector<std::string>& inFiles, unsigned threadCount, const Options& options, PassStatistics& statistics);
+bool generateCode(ProgramNode* program, const std::string& outFile, const Options& options, ThreadPool& pool, PassStatistics& statistics, std::vector<std::string>& errors);
+std::string getOutputPath(const std::string& inFile);
+void reportErrors(const std::string& inFile, const std::vector<std::string>& errors);
+bool parseThreadCount(const std::string& text, unsigned& threadCount);
+void printUsage();
+
+/**
+ * Usage:
+ *   prism [--stats] [--pipeline] [--dump-tac] <input> <output>
+ *   prism [--stats] [--pipeline] [--dump-tac] --batch [-j <threads>] <input>...
+ *
+ * Batch mode compiles every input on a thread pool and writes each one's
+ * assembly next to it, with the extension replaced by ".s". With --stats,
+ * what the optimization passes did is reported once everything is compiled.
+ * With --pipeline, each file is lexed on its own thread while it is parsed,
+ * which pays off for large files. With --dump-tac, the three address code
+ * each function is lowered from is printed.
+ */
 int main(int argc, char* argv[])
 {
+    std::vector<std::string> arguments;
+    bool isPrintingStatistics = false;
+    Options options;
+    for (int i = 1; i < argc; i++)
+    {
+        if (std::string(argv[i]) == "--stats")
+        {
+            isPrintingStatistics = true;
+        }
+        else if (std::string(argv[i]) == "--pipeline")
+        {
+            options.isPipelined = true;
+        }
+        else if (std::string(argv[i]) == "--dump-tac")
+        {
+            options.isDumpingTAC = true;
+        }
+        else
+        {
+            arguments.push_back(argv[i]);
+        }
+    }
+
+    PassStatistics statistics;
+    bool isSuccessful;
+    if (arguments.size() == 2 && arguments[0] != "--batch")
+    {
+        ThreadPool pool(ThreadPool::getDefaultThreadCount());
+        isSuccessful = compile(arguments[0], arguments[1], options, pool, statistics);
+    }
+    else
+    {
+        if (arguments.empty() || arguments[0] != "--batch")
+        {
+            printUsage();
+            return EXIT_FAILURE;
+        }
+
+        unsigned threadCount = ThreadPool::getDefaultThreadCount();
+        std::vector<std::string> inFiles;
+        for (size_t i = 1; i < arguments.size(); i++)
+        {
+            if (arguments[i] == "-j")
+            {
+                if (i + 1 == arguments.size() || !parseThreadCount(arguments[++i], threadCount))
+                {
+                    printUsage();
+                    return EXIT_FAILURE;
+                }
+            }
+            else
+            {
+                inFiles.push_back(arguments[i]);
+            }
+        }
+        if (inFiles.empty())
+        {
+            printUsage();
+            return EXIT_FAILURE;
+        }
+        isSuccessful = compileBatch(inFiles, threadCount, options, statistics);
+    }
+
+    if (isPrintingStatistics)
+    {
+        BufferSink report;
+        statistics.print(report);
+        std::cerr << report.getText();
+    }
+    return isSuccessful ? 0 : EXIT_FAILURE;
+}
+
+void printUsage()
+{
+    std::cerr << "Usage: prism [--stats] [--pipeline] [--dump-tac] <input> <output>\n"
+        "       prism [--stats] [--pipeline] [--dump-tac] --batch [-j <threads>] <input>...\n";
+}
 
-    compile(argv[1], argv[2]);
-    return 0;
+/**
+ * Reads the value of -j. The calling thread works too, so -j counts it as one
+ * of the threads and the pool gets one fewer.
+ */
+bool parseThreadCount(const std::string& text, unsigned& threadCount)
+{
+    char* end = nullptr;
+    long requested = std::strtol(text.c_str(), &end, 10);
+    if (text.empty() || *end != '\0' || requested < 1 || requested > 1024)
+    {
+        return false;
+    }
+    threadCount = (unsigned)requested - 1;
+    return true;
 }
 
-void compile(std::string inFile, std::string outFile)
+/**
+ * Compiles a single file and returns false if it has errors. Every
+ * compilation has its own parser, checker and code generator, so any number
+ * of them can run at once. The pool is used to check and generate code for
+ * the file's functions in parallel.
+ */
+bool compile(std::string inFile, std::string outFile, const Options& options, ThreadPool& pool, PassStatistics& statistics)
 {
-    x86Visitor compiler;
-    TypeCheckingVisitor typeChecker;
-    PrintVisitor p;
-    Parser parser("in.txt");
+    Parser parser(inFile, options.isPipelined);
     ASTNode* AST = parser.parseProgram();
-    AST->accept(compiler);
-    GenTACVisitor gtv;
-    AST->accept(gtv);
+    if (!AST)
+    {
+        reportErrors(inFile, parser.getErrors());
+        return false;
+    }
+
+    TypeCheckingVisitor typeChecker(&pool);
+    if (!typeChecker.check(AST))
+    {
+        reportErrors(inFile, typeChecker.getErrors());
+        return false;
+    }
+
+    std::vector<std::string> errors;
+    if (!generateCode(static_cast<ProgramNode*>(AST), outFile, options, pool, statistics, errors))
+    {
+        reportErrors(inFile, errors);
+        return false;
+    }
+    return true;
+}
+
+/**
+ * Reports a file's errors in one write so that concurrent compilations do
+ * not interleave
+ */
+void reportErrors(const std::string& inFile, const std::vector<std::string>& errors)
+{
+    std::string report;
+    for (const auto& error : errors)
+    {
+        report += inFile + ": " + error + "\n";
+    }
+    std::cerr << report;
+}
+
+/**
+ * Writes the program's assembly. Each function is turned into three address
+ * code, taken through SSA form, optimized and lowered to x86-64 on its own,
+ * into its own buffer, so functions are compiled in parallel; the buffers
+ * are written out in source order so the output never depends on timing.
+ * If any function cannot be lowered, its errors are collected in source
+ * order and no output is written. Failing to write the output file is an
+ * error of this file alone. Dumped three address code goes to stderr in one
+ * write, also in source order.
+ */
+bool generateCode(ProgramNode* program, const std::string& outFile, const Options& options, ThreadPool& pool, PassStatistics& statistics, std::vector<std::string>& errors)
+{
+    auto units = program->getProgramUnits();
+    std::vector<BufferSink> buffers(units.size());
+    std::vector<BufferSink> dumps(options.isDumpingTAC ? units.size() : 0);
+    std::vector<std::vector<std::string>> loweringErrors(units.size());
+    pool.parallelFor(units.size(), [&](size_t i)
+    {
+        GenTACVisitor generator;
+        TACFunction function = generator.generate(units[i]);
+        SSABuilder ssaBuilder;
+        ssaBuilder.build(function);
+        ConstantPropagator constantPropagator;
+        constantPropagator.propagate(function);
+        statistics.foldedInstructions += constantPropagator.getFoldedCount();
+        statistics.prunedBranches += constantPropagator.getPrunedBranchCount();
+        DeadCodeEliminator deadCodeEliminator;
+        deadCodeEliminator.eliminate(function);
+        statistics.removedInstructions += deadCodeEliminator.getRemovedInstructionCount();
+        statistics.removedBlocks += deadCodeEliminator.getRemovedBlockCount();
+        ValueNumberer valueNumberer;
+        valueNumberer.number(function);
+        statistics.eliminatedComputations += valueNumberer.getEliminatedCount();
+        SSADestructor ssaDestructor;
+        ssaDestructor.destruct(function);
+        if (options.isDumpingTAC)
+        {
+            function.print(dumps[i]);
+        }
+        x86Lowering lowering(buffers[i], (int)i);
+        if (!lowering.lower(function))
+        {
+            loweringErrors[i] = lowering.getErrors();
+        }
+    });
+    if (options.isDumpingTAC)
+    {
+        std::string dump;
+        for (const auto& functionDump : dumps)
+        {
+            dump += functionDump.getText();
+        }
+        std::cerr << dump;
+    }
+    for (const auto& functionErrors : loweringErrors)
+    {
+        errors.insert(errors.end(), functionErrors.begin(), functionErrors.end());
+    }
+    if (!errors.empty())
+    {
+        return false;
+    }
+
+    FileSink out{ outFile };
+    x86Lowering::writeHeader(out, program->getStrings());
+    for (const auto& buffer : buffers)
+    {
+        out << buffer.getText();
+    }
+    out.flush();
+    if (!out.getError().empty())
+    {
+        errors.push_back(out.getError());
+        return false;
+    }
+    return true;
 }
 
+/**
+ * Compiles many files across a thread pool and returns false if any failed
+ */
+bool compileBatch(const std::vector<std::string>& inFiles, unsigned threadCount, const Options& options, PassStatistics& statistics)
+{
+    ThreadPool pool(threadCount);
+    std::atomic<bool> isSuccessful{ true };
+    pool.parallelFor(inFiles.size(), [&](size_t i)
+    {
+        if (!compile(inFiles[i], getOutputPath(inFiles[i]), options, pool, statistics))
+        {
+            isSuccessful = false;
+        }
+    });
+    return isSuccessful;
+}
+
+/**
+ * Returns the input path with its extension, if any, replaced by ".s"
+ */
+std::string getOutputPath(const std::string& inFile)
+{
+    size_t dot = inFile.find_last_of('.'), slash = inFile.find_last_of("/\\");
+    if (dot == std::string::npos || (slash != std::string::npos && dot < slash))
+    {
+        return inFile + ".s";
+    }
+    return inFile.substr(0, dot) + ".s";
+}
@@ -0,0 +1,223 @@
+#include "../include/DominatorTree.h"
+#include <algorithm>
+#include <utility>
+
+/**
+ * Constructor. Numbers the reachable blocks in reverse postorder, then
+ * refines every block's immediate dominator until nothing changes; with
+ * that order, graphs without irreducible loops settle in two passes.
+ */
+DominatorTree::DominatorTree(const TACFunction& function)
+{
+    size_t blockCount = function.blocks.size();
+    immediateDominators.assign(blockCount, NoBlock);
+    children.assign(blockCount, {});
+    orderNumbers.assign(blockCount, UINT32_MAX);
+    preorderStarts.assign(blockCount, 0);
+    preorderEnds.assign(blockCount, 0);
+
+    //Depth-first search on an explicit stack of blocks and their next successor
+    std::vector<uint8_t> isVisited(blockCount, 0);
+    std::vector<std::pair<BlockId, uint32_t>> stack{ { 0, 0 } };
+    isVisited[0] = 1;
+    while (!stack.empty())
+    {
+        BlockId id = stack.back().first;
+        uint32_t next = stack.back().second;
+        const std::vector<BlockId>& successors = function.blocks[id].successors;
+        if (next < successors.size())
+        {
+            stack.back().second++;
+            BlockId successor = successors[next];
+            if (!isVisited[successor])
+            {
+                isVisited[successor] = 1;
+                stack.push_back({ successor, 0 });
+            }
+            continue;
+        }
+        reversePostorder.push_back(id);
+        stack.pop_back();
+    }
+    std::reverse(reversePostorder.begin(), reversePostorder.end());
+    for (uint32_t i = 0; i < reversePostorder.size(); i++)
+    {
+        orderNumbers[reversePostorder[i]] = i;
+    }
+
+    immediateDominators[0] = 0;
+    walkMarks.assign(blockCount, 0);
+    bool isChanged = true;
+    while (isChanged)
+    {
+        isChanged = false;
+        for (size_t i = 1; i < reversePostorder.size(); i++)
+        {
+            BlockId id = reversePostorder[i];
+            BlockId dominator = NoBlock;
+            walkMark++;
+            for (BlockId predecessor : function.blocks[id].predecessors)
+            {
+                if (immediateDominators[predecessor] == NoBlock)
+                {
+                    continue;
+                }
+                if (dominator == NoBlock)
+                {
+                    dominator = predecessor;
+                    walkMarks[predecessor] = walkMark;
+                }
+                else
+                {
+                    dominator = intersect(predecessor, dominator);
+                }
+            }
+            if (immediateDominators[id] != dominator)
+            {
+                immediateDominators[id] = dominator;
+                isChanged = true;
+            }
+        }
+    }
+
+    for (size_t i = 1; i < reversePostorder.size(); i++)
+    {
+        BlockId id = reversePostorder[i];
+        children[immediateDominators[id]].push_back(id);
+    }
+
+    //A block dominates exactly the blocks inside its span of the tree's preorder
+    uint32_t counter = 0;
+    stack.assign({ { 0, 0 } });
+    preorderStarts[0] = counter++;
+    while (!stack.empty())
+    {
+        BlockId id = stack.back().first;
+        uint32_t next = stack.back().second;
+        if (next < children[id].size())
+        {
+            stack.back().second++;
+            BlockId child = children[id][next];
+            preorderStarts[child] = counter++;
+            stack.push_back({ child, 0 });
+            continue;
+        }
+        preorderEnds[id] = counter;
+        stack.pop_back();
+    }
+}
+
+/**
+ * Returns the closest common dominator of a predecessor and the dominator
+ * found so far for its block, by walking up from whichever comes later in
+ * reverse postorder.
+ *
+ * Every block walked through for the same block is marked, and lies below
+ * the dominator found so far, which only ever moves up. A walk that reaches
+ * a marked block can stop there, so a join with many predecessors down one
+ * chain of the tree walks each block of the chain once rather than once per
+ * predecessor.
+ */
+BlockId DominatorTree::intersect(BlockId left, BlockId right)
+{
+    while (left != right)
+    {
+        while (orderNumbers[left] > orderNumbers[right])
+        {
+            if (walkMarks[left] == walkMark)
+            {
+                return right;
+            }
+            walkMarks[left] = walkMark;
+            left = immediateDominators[left];
+        }
+        while (orderNumbers[right] > orderNumbers[left])
+        {
+            walkMarks[right] = walkMark;
+            right = immediateDominators[right];
+        }
+    }
+    return left;
+}
+
+/**
+ * Returns the immediate dominator of a block, or NoBlock for the entry and
+ * for unreachable blocks
+ */
+BlockId DominatorTree::getImmediateDominator(BlockId block) const
+{
+    return block == 0 ? NoBlock : immediateDominators[block];
+}
+
+const std::vector<BlockId>& DominatorTree::getChildren(BlockId block) const
+{
+    return children[block];
+}
+
+/**
+ * Returns the reachable blocks in reverse postorder, which visits every
+ * block before its successors except along loop back edges
+ */
+const std::vector<BlockId>& DominatorTree::getReversePostorder() const
+{
+    return reversePostorder;
+}
+
+bool DominatorTree::isReachable(BlockId block) const
+{
+    return orderNumbers[block] != UINT32_MAX;
+}
+
+/**
+ * Returns whether every path from the entry to the block passes through the
+ * dominator. A block dominates itself.
+ */
+bool DominatorTree::dominates(BlockId dominator, BlockId block) const
+{
+    if (!isReachable(dominator) || !isReachable(block))
+    {
+        return false;
+    }
+    return preorderStarts[dominator] <= preorderStarts[block] && preorderStarts[block] < preorderEnds[dominator];
+}
+
+/**
+ * Returns the dominance frontier of every block: the blocks where its
+ * dominance ends because they can also be reached some other way. Each join
+ * point is added to the frontier of the blocks on the way up from each of its
+ * predecessors to its immediate dominator.
+ */
+std::vector<std::vector<BlockId>> DominatorTree::getDominanceFrontiers(const TACFunction& function) const
+{
+    std::vector<std::vector<BlockId>> frontiers(function.blocks.size());
+    for (BlockId id : reversePostorder)
+    {
+        const std::vector<BlockId>& predecessors = function.blocks[id].predecessors;
+        if (predecessors.size() < 2)
+        {
+            continue;
+        }
+        for (BlockId predecessor : predecessors)
+        {
+            if (!isReachable(predecessor))
+            {
+                continue;
+            }
+            for (BlockId runner = predecessor; runner != immediateDominators[id]; runner = immediateDominators[runner])
+            {
+                //Blocks are finished one at a time, so a repeat can only be the last entry. It
+                //means an earlier predecessor's walk came through here and did the rest of the way up.
+                if (!frontiers[runner].empty() && frontiers[runner].back() == id)
+                {
+                    break;
+                }
+                frontiers[runner].push_back(id);
+                if (runner == 0)
+                {
+                    break;
+                }
+            }
+        }
+    }
+    return frontiers;
+}
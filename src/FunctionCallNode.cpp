@@ -1,16 +1,28 @@
 #include "../include/FunctionCallNode.h"
 #include "../include/Visitor.h"
-FunctionCallNode::FunctionCallNode(std::string identifier, std::vector<ASTNode*> args)
+#include <utility>
+FunctionCallNode::FunctionCallNode(Symbol symbol, std::string_view identifier, std::vector<ASTNode*> args) : ASTNode(FunctionCallKind)
 {
+    this->symbol = symbol;
     this->identifier = identifier;
-    this->arguments = args;
+    this->arguments = std::move(args);
 };
 
 void FunctionCallNode::accept(Visitor& v)
 {
     v.visitFunctionCallNode(this);
 }
-std::string FunctionCallNode::getIdentifier()
+std::string_view FunctionCallNode::getIdentifier()
 {
     return this->identifier;
 }
+
+Symbol FunctionCallNode::getSymbol()
+{
+    return this->symbol;
+}
+
+Span<ASTNode*> FunctionCallNode::getArguments()
+{
+    return Span<ASTNode*>(arguments.data(), arguments.size());
+}
\ No newline at end of file
@@ -1,9 +1,10 @@
 #include "../include/FunctionDeclarationNode.h"
 #include "../include/Visitor.h"
+#include <utility>
 
-std::vector<std::pair<VariableDeclarationNode*, Type>> FunctionDeclarationNode::getParameterList()
+Span<std::pair<VariableDeclarationNode*, Type>> FunctionDeclarationNode::getParameterList()
 {
-    return this->parameterList;
+    return Span<std::pair<VariableDeclarationNode*, Type>>(parameterList.data(), parameterList.size());
 }
 
 Type FunctionDeclarationNode::getReturnType()
@@ -21,21 +22,21 @@ void FunctionDeclarationNode::accept(Visitor& v)
     v.visitFunctionDeclarationNode(this);
 }
 
-FunctionDeclarationNode::FunctionDeclarationNode(std::string functionName, Type returnType, std::vector<std::pair<VariableDeclarationNode*, Type>> parameterList, ASTNode* functionBody)
+FunctionDeclarationNode::FunctionDeclarationNode(std::string_view functionName, Type returnType, std::vector<std::pair<VariableDeclarationNode*, Type>> parameterList, ASTNode* functionBody) : ASTNode(FunctionDeclarationKind)
 {
     this->functionName = functionName;
     this->returnType = returnType;
-    this->parameterList = parameterList;
+    this->parameterList = std::move(parameterList);
     this->functionBody = functionBody;
 }
 
-FunctionDeclarationNode::FunctionDeclarationNode(Type returnType, std::string functionName)
+FunctionDeclarationNode::FunctionDeclarationNode(Type returnType, std::string_view functionName) : ASTNode(FunctionDeclarationKind)
 {
     this->returnType = returnType;
     this->functionName = functionName;
 }
 
-std::string FunctionDeclarationNode::getFunctionName()
+std::string_view FunctionDeclarationNode::getFunctionName()
 {
     return this->functionName;
 }
@@ -7,356 +7,410 @@
 #include "../include/IntegerLiteralNode.h"
 #include "../include/VariableDeclarationNode.h"
 #include "../include/BooleanLiteralNode.h"
-#include "../include/Visitor.h"
 #include "../include/VariableNode.h"
 #include "../include/FunctionDeclarationNode.h"
 #include "../include/ReturnNode.h"
 #include "../include/ProgramNode.h"
-#include "../include/Type.h"
 #include "../include/FunctionCallNode.h"
-#include "../include/StringSymbolTable.h"
 #include "../include/StringLiteralNode.h"
-#include <iostream>
+#include "../include/WhileNode.h"
+
+/**
+ * Returns the three address code of the given function declaration. Blocks
+ * are numbered in the order they are started, which follows the source, so
+ * that the fall-through path of each if and while is laid out next.
+ */
+TACFunction GenTACVisitor::generate(ASTNode* node)
+{
+    walk(node);
+    function.reorderBlocks(layout);
+    return std::move(function);
+}
 
-void GenTACVisitor::visitBinaryOperatorNode(BinaryOperatorNode* node)
+/**
+ * Creates the blocks a node needs before any of its children are generated
+ */
+void GenTACVisitor::enterNode(ASTNode* node)
 {
-    int l, r;
-    std::string lName, rName;
-    switch (node->op)
+    Context entered = { conditionTrue != NoBlock, conditionTrue, conditionFalse, NoBlock, NoBlock, 0 };
+    conditionTrue = conditionFalse = NoBlock;
+    switch (node->getKind())
     {
-        case AdditionOperator:
-            node->left->accept(*this);
-            l = this->allocatedRegister;
-            lName = this->currentName;
-
-            node->right->accept(*this);
-            r = this->allocatedRegister;
-            rName = this->currentName;
-
-            //std::cout << "\taddq t" << l << ", t" << r << "\n";
-            this->currentName = "t" + std::to_string(allocateRegister());
-            std::cout << "addq " << lName << "," << currentName << "\n";
-            this->allocatedRegister = r;
-            break;
-        case SubtractionOperator:
-            node->left->accept(*this);
-            l = this->allocatedRegister;
-            lName = this->currentName;
-
-            node->right->accept(*this);
-            r = this->allocatedRegister;
-            rName = this->currentName;
-
-            //std::cout << "\taddq t" << l << ", t" << r << "\n";
-            this->currentName = "t" + std::to_string(allocateRegister());
-            std::cout << currentName << " = " << lName << " - " << rName << "\n";
-            this->allocatedRegister = r;
-            break;
-        case MultiplicationOperator:
-            node->left->accept(*this);
-            lName = this->currentName;
-            l = this->allocatedRegister;
-            node->right->accept(*this);
-            r = this->allocatedRegister;
-            rName = this->currentName;
-            this->currentName = "t" + std::to_string(allocateRegister());
-            std::cout << currentName << " = " << lName << " * " << rName << "\n";
-            this->allocatedRegister = r;
+        case BinaryOperatorKind:
+        {
+            if (!isShortCircuit(node))
+            {
+                break;
+            }
+            if (!entered.isCondition)
+            {
+                //Used as a value, the result is stored to a slot of its own on each path and loaded where they meet
+                entered.slot = function.slotCount++;
+                entered.ifTrue = function.newBlock();
+                entered.ifFalse = function.newBlock();
+                entered.end = function.newBlock();
+            }
+            entered.right = function.newBlock();
             break;
-        case AssignmentOperator:
-            //Loads the result into the register
-            if (node->left)
+        }
+        case IfStatementKind:
+        {
+            entered.ifTrue = function.newBlock();
+            entered.ifFalse = static_cast<IfStatementNode*>(node)->getElseBody() ? function.newBlock() : NoBlock;
+            entered.end = function.newBlock();
+            if (entered.ifFalse == NoBlock)
             {
-                node->left->accept(*this);
-                l = this->allocatedRegister;
-                lName = this->currentName;
-
+                entered.ifFalse = entered.end;
             }
-            //This moves the result from the register into the variable's location
-            if (node->right)
+            break;
+        }
+        case WhileKind:
+        {
+            entered.right = function.newBlock();
+            entered.ifTrue = function.newBlock();
+            entered.ifFalse = entered.end = function.newBlock();
+            jumpTo(entered.right);
+            startBlock(entered.right);
+            break;
+        }
+        case FunctionDeclarationKind:
+        {
+            auto declaration = static_cast<FunctionDeclarationNode*>(node);
+            auto parameters = declaration->getParameterList();
+            function.name = declaration->getFunctionName();
+            function.parameterCount = (uint32_t)parameters.size();
+            function.slotCount = declaration->slotCount;
+
+            //Parameters are copied into their slots on entry like any other local
+            startBlock(function.newBlock());
+            for (uint32_t i = 0; i < parameters.size(); i++)
             {
-                isAssignment = true;
-                node->right->accept(*this);
-                isAssignment = false;
+                TACOperand parameter = emitValue(ParameterOp, TACOperand::makeImmediate(i));
+                emit(StoreOp, NoRegister, TACOperand::makeImmediate(parameters[i].first->getSlot()), parameter);
             }
-            std::cout << "movq " << lName << ", " << variableName << "\n";
             break;
-        case LessThanOperator:
-        case LessThanOrEqualToOperator:
-        case GreaterThanOperator:
-        case GreaterThanOrEqualToOperator:
-        case EqualsOperator:
-            node->left->accept(*this);
-            l = this->allocatedRegister;
-            node->right->accept(*this);
-            r = this->allocatedRegister;
-            std::string instruction = invertInstruction(node);
-            std::cout << "\tcmpq t" << r << ", t" << l << "\n";
-            std::cout << "\t" << instruction << " .L" << this->currentLabel << "\n";
+        }
+        default:
             break;
     }
-};
-
-void GenTACVisitor::visitIntegerLiteralNode(IntegerLiteralNode* node)
-{
-    //int store = allocateRegister();
-    //std::cout << "t" << store << " = " << node->value << "\n";
-    //this->allocatedRegister = store;
-    this->currentName = "$" + std::to_string(node->value);
+    contexts.push_back(entered);
 }
 
-void GenTACVisitor::visitCompoundStatementNode(CompoundStatementNode* node)
+/**
+ * Ends the current block wherever control flow splits between two children,
+ * and hands a child that is a condition the blocks it branches to. Variables
+ * that are stored to rather than loaded are skipped.
+ */
+bool GenTACVisitor::beforeChild(ASTNode* node, uint32_t index)
 {
-    scope++;
-    for (const auto& statement : node->getStatements())
+    const Context& current = contexts.back();
+    switch (node->getKind())
     {
-        statement->accept(*this);
-    }
-    scope--;
-
-    /**
-     * Once we leave the innter scope, we pop all the locals associated with it
-     * as they are no longer visible to the outer scope
-     */
-    while (locals.size() > 0 && locals.back().getScope() > scope)
-    {
-        locals.pop_back();
+        case BinaryOperatorKind:
+        {
+            auto binaryOperator = static_cast<BinaryOperatorNode*>(node);
+            if (binaryOperator->op == AssignmentOperator)
+            {
+                //The parser puts the assigned value on the left and the variable on the right
+                return index == 0;
+            }
+            if (!isShortCircuit(node))
+            {
+                return true;
+            }
+            if (index == 0)
+            {
+                if (binaryOperator->op == LogicalAndOperator)
+                {
+                    setCondition(current.right, current.ifFalse);
+                }
+                else
+                {
+                    setCondition(current.ifTrue, current.right);
+                }
+                return true;
+            }
+            startBlock(current.right);
+            setCondition(current.ifTrue, current.ifFalse);
+            return true;
+        }
+        case VariableDeclarationKind:
+            return index != 0;
+        case FunctionDeclarationKind:
+            return index == static_cast<FunctionDeclarationNode*>(node)->getParameterList().size();
+        case IfStatementKind:
+        {
+            if (index == 0)
+            {
+                setCondition(current.ifTrue, current.ifFalse);
+            }
+            else if (index == 1)
+            {
+                startBlock(current.ifTrue);
+            }
+            else
+            {
+                jumpTo(current.end);
+                startBlock(current.ifFalse);
+            }
+            return true;
+        }
+        case WhileKind:
+        {
+            if (index == 0)
+            {
+                setCondition(current.ifTrue, current.ifFalse);
+            }
+            else
+            {
+                startBlock(current.ifTrue);
+            }
+            return true;
+        }
+        default:
+            return true;
     }
 }
 
-void GenTACVisitor::visitIfStatementNode(IfStatementNode* node)
+/**
+ * Generates a node once its children are done and leaves its result on the
+ * stack for its parent. A condition branches on its result instead, except
+ * for && and ||, whose sides have already branched.
+ */
+void GenTACVisitor::leaveNode(ASTNode* node)
 {
-    int endIfLabel = allocateLabel(), elseLabel = allocateLabel();
-    this->currentLabel = elseLabel;
-
-    //Generate x86-64 assembly for the condition
-    node->getCondition()->accept(*this);
-    freeAllRegisters();
-
-    //Generate x86-64 assembly for the body of the if statement
-    node->getIfStmtBody()->accept(*this);
-    freeAllRegisters();
-
-    //If the condition is true, jump to the end of the if statement
-    jumpToLabel(endIfLabel);
-
-
-    printLabel(elseLabel);
-    if (node->getElseBody())
+    this->context = contexts.back();
+    contexts.pop_back();
+    visit(node);
+    if (context.isCondition && !isShortCircuit(node))
     {
-        node->getElseBody()->accept(*this);
+        branchTo(this->value, context.ifTrue, context.ifFalse);
+        this->value = {};
     }
-    printLabel(endIfLabel);
+    values.push_back(this->value);
 }
 
-void GenTACVisitor::visitBooleanLiteralNode(BooleanLiteralNode* node)
+TACOperand GenTACVisitor::popValue()
 {
-
+    TACOperand top = values.back();
+    values.pop_back();
+    return top;
 }
 
-void GenTACVisitor::visitReturnNode(ReturnNode* node)
+/**
+ * Makes the next child entered a condition that branches to ifTrue or ifFalse
+ */
+void GenTACVisitor::setCondition(BlockId ifTrue, BlockId ifFalse)
 {
-    // std::cout << "END FUNCITON LABEL: " << this->endFunctionLabel << "\n";
-
- //Generate the code for the return value
-    node->toReturn->accept(*this);
-    //Move the result into rax
-    std::cout << "\tmovq " << this->allocatedRegister << ", " << "%rax" << "\t\t# store the return value into %rax\n";
-    jumpToLabel(this->endFunctionLabel);
+    this->conditionTrue = ifTrue;
+    this->conditionFalse = ifFalse;
 }
 
-void GenTACVisitor::visitFunctionDeclarationNode(FunctionDeclarationNode* node)
+void GenTACVisitor::visitBinaryOperatorNode(BinaryOperatorNode* node)
 {
-    scope++;
-    Type argType;
-    this->endFunctionLabel = allocateLabel();
-
-    std::string label = node->getFunctionName();
-    std::cout << "\n" << label << ":\n";
-    std::cout << "\tpushq %rbp \t\t# save the base pointer\n\tmovq %rsp, %rbp \t# set new base pointer\n\n";
-    std::cout << "\tsubq $" << node->stackOffset << ", %rsp\n";
-
-    std::cout << "\n\tpushq %rbx \t\t# save callee-saved registers\n"
-        "\tpushq %r12\n"
-        "\tpushq %r13\n"
-        "\tpushq %r14\n"
-        "\tpushq %r15\n\n";
-    int index = 0;
-    for (auto& parameter : node->parameterList)
+    switch (node->op)
     {
-        parameter.first->accept(*this);
-        //std::cout << "\tmovq " << argumentRegisters[index++] << ", " << (localOffset) << "(%rbp)\n";
+        case AssignmentOperator:
+        {
+            //Only the assigned value was generated, and it is also the result
+            this->value = popValue();
+            auto variable = static_cast<VariableNode*>(node->right);
+            emit(StoreOp, NoRegister, TACOperand::makeImmediate(variable->getSlot()), this->value);
+            break;
+        }
+        case LogicalAndOperator:
+        case LogicalOrOperator:
+        {
+            values.resize(values.size() - 2);
+            this->value = {};
+            if (context.isCondition)
+            {
+                break;
+            }
+            TACOperand slot = TACOperand::makeImmediate(context.slot);
+            startBlock(context.ifTrue);
+            emit(StoreOp, NoRegister, slot, TACOperand::makeImmediate(1));
+            jumpTo(context.end);
+            startBlock(context.ifFalse);
+            emit(StoreOp, NoRegister, slot, TACOperand::makeImmediate(0));
+            jumpTo(context.end);
+            startBlock(context.end);
+            this->value = emitValue(LoadOp, slot);
+            break;
+        }
+        default:
+        {
+            TACOperand right = popValue();
+            TACOperand left = popValue();
+            this->value = emitValue(getOpcode(node), left, right);
+            break;
+        }
     }
+};
 
-    node->getFunctionBody()->accept(*this);
-
-    printLabel(endFunctionLabel);
+void GenTACVisitor::visitIntegerLiteralNode(IntegerLiteralNode* node)
+{
+    this->value = TACOperand::makeImmediate(node->value);
+}
 
-    std::cout << "\n\tpopq %r15 \t\t# restore callee-saved registers\n"
-        "\tpopq %r14\n"
-        "\tpopq %r13\n"
-        "\tpopq %r12\n"
-        "\tpopq %rbx\n"
-        "\n\tmovq %rbp, %rsp\t\t# reset stack to base pointer.\n"
-        "\tpopq %rbp \t\t# restore the old base pointer\n"
-        "\tret\t\t\t# return to caller\n";
+void GenTACVisitor::visitCompoundStatementNode(CompoundStatementNode* node)
+{
+    values.resize(values.size() - node->getStatements().size());
+    this->value = {};
+}
 
+void GenTACVisitor::visitIfStatementNode(IfStatementNode* node)
+{
+    values.resize(values.size() - (node->getElseBody() ? 3 : 2));
+    jumpTo(context.end);
+    startBlock(context.end);
+    this->value = {};
+}
 
-    while (locals.size() > 0)
-    {
-        locals.pop_back();
-    }
-    scope--;
-    //localOffset = 0;
+void GenTACVisitor::visitBooleanLiteralNode(BooleanLiteralNode* node)
+{
+    this->value = TACOperand::makeImmediate(node->value ? 1 : 0);
 }
 
-void GenTACVisitor::visitFunctionCallNode(FunctionCallNode* node)
+void GenTACVisitor::visitReturnNode(ReturnNode* node)
 {
-    std::cout << "\tpushq %r10\n\tpushq %r11\n";
+    TACOperand result = node->toReturn ? popValue() : TACOperand::makeImmediate(0);
+    emit(ReturnOp, NoRegister, result);
 
-    for (int i = node->arguments.size() - 1; i >= 0; i--)
-    {
-        node->arguments[i]->accept(*this);
-        //std::cout << "\tmovq " << registerMap[this->allocatedRegister].first << ", " << argumentRegisters[i] << "\n";
-    }
-    std::cout << "\tmovq $0, %rax\n";
-    std::cout << "\tcall " << node->getIdentifier() << "\n";
-    std::cout << "\tpopq %r11\n\tpopq %r10\n";
-    int r = allocateRegister();
-    std::cout << "\tmovq %rax, " << r << "\n";
-    this->allocatedRegister = r;
+    //Anything after the return in the same block is unreachable and gets a block of its own
+    startBlock(function.newBlock());
+    this->value = {};
 }
 
-void GenTACVisitor::visitProgramNode(ProgramNode* node)
+void GenTACVisitor::visitFunctionDeclarationNode(FunctionDeclarationNode*)
 {
-    std::cout << ".global main\n";
-    std::cout << ".data\n";
-    std::cout << ".text\n\n";
-
-    for (const auto& entry : StringSymbolTable::table)
-    {
-        printLabel(entry.second);
-        labelCount++;
-        std::cout << "\t.string " << entry.first << "\n";
-    }
+    //Only the body was walked
+    popValue();
 
-    for (const auto& programUnit : node->getProgramUnits())
-    {
-        programUnit->accept(*this);
-        freeAllRegisters();
-    }
+    //Falling off the end of a function returns 0
+    emit(ReturnOp, NoRegister, TACOperand::makeImmediate(0));
+    this->value = {};
 }
 
-void GenTACVisitor::visitWhileNode(WhileNode* node)
+void GenTACVisitor::visitFunctionCallNode(FunctionCallNode* node)
 {
+    //Arguments are evaluated left to right, then passed in order just before the call
+    size_t argumentCount = node->getArguments().size(), first = values.size() - argumentCount;
+    for (uint32_t i = 0; i < argumentCount; i++)
+    {
+        emit(ArgumentOp, NoRegister, TACOperand::makeImmediate(i), values[first + i]);
+    }
+    values.resize(first);
 
+    uint32_t callee = (uint32_t)function.callees.size();
+    function.callees.push_back(node->getIdentifier());
+    this->value = emitValue(CallOp, TACOperand::makeImmediate(callee), TACOperand::makeImmediate(argumentCount));
 }
 
-void GenTACVisitor::visitStringLiteralNode(StringLiteralNode* node)
+/**
+ * Functions are generated one at a time with generate, so that each can be
+ * compiled on its own thread
+ */
+void GenTACVisitor::visitProgramNode(ProgramNode*)
 {
-    //reg stringRegister = allocateRegister();
-    std::cout << "\tmovq $.L" << StringSymbolTable::table[node->value] << ", ";
-    // std::cout << registerMap[stringRegister].first << "\n";
-    //this->allocatedRegister = stringRegister;
 }
 
-int GenTACVisitor::allocateRegister()
+void GenTACVisitor::visitWhileNode(WhileNode*)
 {
-    return tempCount++;
+    values.resize(values.size() - 2);
+    jumpTo(context.right);
+    startBlock(context.end);
+    this->value = {};
 }
 
-int GenTACVisitor::allocateLabel()
+void GenTACVisitor::visitStringLiteralNode(StringLiteralNode* node)
 {
-    return labelCount++;
+    this->value = TACOperand::makeString(node->poolIndex);
 }
 
-
-
-
 void GenTACVisitor::visitVariableDeclarationNode(VariableDeclarationNode* node)
 {
-    // localOffset -= 8;
-    // locals.push_back(Local(node->getIdentifier(), scope, localOffset));
-
     if (node->getRHS())
     {
-        node->getRHS()->accept(*this);
-        std::cout << node->getIdentifier() << " = " << this->currentName << "\n";
-        //std::cout << "\tmovq t" << this->allocatedRegister << "\n";
+        emit(StoreOp, NoRegister, TACOperand::makeImmediate(node->getSlot()), popValue());
     }
+    this->value = {};
 }
 
-int GenTACVisitor::resolveLocal(std::string identifier)
+void GenTACVisitor::visitVariableNode(VariableNode* node)
 {
-    for (int i = locals.size() - 1; i >= 0; i--)
-    {
-        if (identifier == locals[i].getIdentifier())
-        {
-            return locals[i].localOffset;
-        }
-    }
-    return -1;
+    this->value = emitValue(LoadOp, TACOperand::makeImmediate(node->getSlot()));
 }
 
-std::string GenTACVisitor::invertInstruction(BinaryOperatorNode* node)
+void GenTACVisitor::emit(TACOpcode op, VirtualRegister result, TACOperand a, TACOperand b)
 {
-    switch (node->op)
-    {
-        case LessThanOperator:
-            return "jge";
-        case LessThanOrEqualToOperator:
-            return "jg";
-        case GreaterThanOperator:
-            return "jle";
-        case GreaterThanOrEqualToOperator:
-            return "jl";
-        case EqualsOperator:
-            return "jne";
-    }
-    return "unknown";
-
+    function.blocks[currentBlock].instructions.push_back({ op, result, a, b });
 }
 
-void GenTACVisitor::visitVariableNode(VariableNode* node)
+/**
+ * Emits an instruction that defines a new register and returns the register
+ */
+TACOperand GenTACVisitor::emitValue(TACOpcode op, TACOperand a, TACOperand b)
 {
-    int offset = resolveLocal(node->getIdentifier());
-    this->variableName = node->getIdentifier();
-    this->currentName = node->getIdentifier();
-    if (!isAssignment)
-    {
-        loadLocal(offset);
-    }
-    else
-    {
-
-    }
-    return;
+    VirtualRegister result = function.newRegister();
+    emit(op, result, a, b);
+    return TACOperand::makeRegister(result);
 }
 
+void GenTACVisitor::jumpTo(BlockId target)
+{
+    emit(JumpOp, NoRegister, {});
+    function.addEdge(currentBlock, target);
+}
 
-void GenTACVisitor::loadLocal(int offset)
+void GenTACVisitor::branchTo(TACOperand condition, BlockId ifTrue, BlockId ifFalse)
 {
-    // int store = allocateRegister();
-    // // std::cout << "\tmovq " << offset << "(%rbp), " << store << "\n";
-    // //std::cout << "t" << store << " = " << this->variableName << "\n";
-    // this->allocatedRegister = store;
-    // this->currentName = n
+    emit(BranchOp, NoRegister, condition);
+    function.addEdge(currentBlock, ifTrue);
+    function.addEdge(currentBlock, ifFalse);
 }
 
-void GenTACVisitor::printLabel(int label)
+/**
+ * Makes the given block the one that instructions are added to. The
+ * previous block must already have ended in a terminator.
+ */
+void GenTACVisitor::startBlock(BlockId block)
 {
-    std::cout << ".L" << label << ":\n";
+    this->currentBlock = block;
+    layout.push_back(block);
 }
 
-void GenTACVisitor::freeAllRegisters()
+bool GenTACVisitor::isShortCircuit(ASTNode* node)
 {
-    // for (int i = 0; i < registerMap.size(); i++)
-    // {
-    //     freeRegister(i);
-    // }
+    if (node->getKind() != BinaryOperatorKind)
+    {
+        return false;
+    }
+    BinaryOperatorType op = static_cast<BinaryOperatorNode*>(node)->op;
+    return op == LogicalAndOperator || op == LogicalOrOperator;
 }
 
-void GenTACVisitor::jumpToLabel(int label)
+TACOpcode GenTACVisitor::getOpcode(BinaryOperatorNode* node)
 {
-    std::cout << "\tJMP .L" << label << "\n";
+    switch (node->op)
+    {
+        case AdditionOperator:
+            return AddOp;
+        case SubtractionOperator:
+            return SubtractOp;
+        case MultiplicationOperator:
+            return MultiplyOp;
+        case DivisionOperator:
+            return DivideOp;
+        case LessThanOperator:
+            return LessThanOp;
+        case LessThanOrEqualToOperator:
+            return LessThanOrEqualToOp;
+        case GreaterThanOperator:
+            return GreaterThanOp;
+        case GreaterThanOrEqualToOperator:
+            return GreaterThanOrEqualToOp;
+        default:
+            return EqualsOp;
+    }
 }
@@ -1,6 +1,6 @@
 #include "../include/IfStatementNode.h"
 #include "../include/Visitor.h"
-IfStatementNode::IfStatementNode(ASTNode* condition, ASTNode* ifStmtBody, ASTNode* elseBody) : condition{ condition }, ifStmtBody{ ifStmtBody }, elseBody{ elseBody } {}
+IfStatementNode::IfStatementNode(ASTNode* condition, ASTNode* ifStmtBody, ASTNode* elseBody) : ASTNode(IfStatementKind), condition{ condition }, ifStmtBody{ ifStmtBody }, elseBody{ elseBody } {}
 
 void IfStatementNode::accept(Visitor& v)
 {
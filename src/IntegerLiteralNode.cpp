@@ -1,6 +1,6 @@
 #include "../include/IntegerLiteralNode.h"
 #include "../include/Visitor.h"
-IntegerLiteralNode::IntegerLiteralNode(int value)
+IntegerLiteralNode::IntegerLiteralNode(int value) : ASTNode(IntegerLiteralKind)
 {
     this->value = value;
 };
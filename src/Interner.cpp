@@ -0,0 +1,58 @@
+#include "../include/Interner.h"
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+/**
+ * Finds where a symbol's text is stored. Numbering the slots from
+ * 2^FirstChunkBits, the position of a slot's highest set bit picks its chunk
+ * and the remaining bits index into it.
+ */
+void Interner::locate(Symbol symbol, unsigned& chunk, size_t& index)
+{
+    uint64_t slot = (uint64_t)symbol + (1u << FirstChunkBits);
+#ifdef _MSC_VER
+    unsigned long highestBit;
+    _BitScanReverse64(&highestBit, slot);
+#else
+    unsigned highestBit = 63 - __builtin_clzll(slot);
+#endif
+    chunk = highestBit - FirstChunkBits;
+    index = slot - ((uint64_t)1 << highestBit);
+}
+
+/**
+ * Returns the symbol for the given text, creating one if it is new. Chunks
+ * are only allocated once the previous one is full, and since the chunk
+ * table is a fixed array it never moves under a concurrent getText.
+ */
+Symbol Interner::intern(std::string_view text)
+{
+    auto entry = symbols.find(text);
+    if (entry != symbols.end())
+    {
+        return entry->second;
+    }
+    Symbol symbol = count++;
+    unsigned chunk;
+    size_t index;
+    locate(symbol, chunk, index);
+    if (index == 0)
+    {
+        chunks[chunk] = std::make_unique<std::string_view[]>((size_t)1 << (FirstChunkBits + chunk));
+    }
+    chunks[chunk][index] = text;
+    symbols.emplace(text, symbol);
+    return symbol;
+}
+
+/**
+ * Returns the text a symbol was interned from
+ */
+std::string_view Interner::getText(Symbol symbol)
+{
+    unsigned chunk;
+    size_t index;
+    locate(symbol, chunk, index);
+    return chunks[chunk][index];
+}
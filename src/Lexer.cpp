@@ -1,24 +1,21 @@
 #include "../include/Lexer.h"
-#include <iostream>
-#include <sstream>
-Lexer::Lexer(std::string text) : file{ text }
-{
-    std::stringstream buffer;
-    buffer << file.rdbuf();
-    this->text = buffer.str();
-}
+#include "../include/Keywords.h"
+#include "../include/CharScanner.h"
+
+/**
+ * Constructor. Identifiers are interned as views into the mapped file, so the
+ * lexer must outlive any use of their text.
+ */
+Lexer::Lexer(std::string text, Interner& interner) : file{ text }, text{ file.getText() }, interner{ interner } {}
 
 /**
  * Skips over any whitespace to reach the next token
  */
 void Lexer::skipWhitespace()
 {
-    if (isspace(getCurrentChar()))
+    if (position < text.size())
     {
-        while (isspace(getCurrentChar()))
-        {
-            advance();
-        }
+        position = CharScanner::skipWhitespace(text.data(), position, text.size());
     }
 }
 
@@ -36,83 +33,26 @@ bool Lexer::hasReachedEOF()
 SyntaxToken Lexer::lex()
 {
     int length;
-    std::string lexeme;
+    std::string_view lexeme;
     skipWhitespace();
-    int start = position;
+    uint32_t start = position;
 
     if (isdigit(getCurrentChar()))
     {
-        while (isdigit(getCurrentChar()))
-        {
-            advance();
-        }
-        length = position - start;
-        lexeme = text.substr(start, length);
-        return SyntaxToken(IntegerLiteralToken, lexeme);
+        position = CharScanner::skipDigits(text.data(), position, text.size());
+        return SyntaxToken(IntegerLiteralToken, start);
     }
     else if (isalpha(getCurrentChar()))
     {
-        while (isalpha(getCurrentChar()))
-        {
-            advance();
-        }
+        position = CharScanner::skipLetters(text.data(), position, text.size());
         length = position - start;
         lexeme = text.substr(start, length);
-        switch (lexeme[0]) //Micro optimization: Check first character for faster look up
+        SyntaxType keyword = Keywords::lookup(lexeme);
+        if (keyword == IdentifierToken)
         {
-            case 'b':
-                if (lexeme == "bool")
-                {
-                    return SyntaxToken(BoolKeywordToken, lexeme);
-                }
-                break;
-            case 'd':
-                if (lexeme == "double") {
-                    return SyntaxToken(DoubleKeywordToken, lexeme);
-                }
-                break;
-            case 'e':
-                if (lexeme == "else") {
-                    return SyntaxToken(ElseToken, lexeme);
-                }
-                break;
-            case 'f':
-                if (lexeme == "false") {
-                    return SyntaxToken(FalseKeywordToken, lexeme);
-                }
-            case 'i':
-                if (lexeme == "if") {
-                    return SyntaxToken(IfToken, lexeme);
-                }
-                else if (lexeme == "int") {
-                    return SyntaxToken(IntKeywordToken, lexeme);
-                }
-                break;
-            case 'p':
-                if (lexeme == "print") {
-                    return SyntaxToken(PrintToken, lexeme);
-                }
-                break;
-            case 'r':
-                if (lexeme == "return") {
-                    return SyntaxToken(ReturnKeyword, lexeme);
-                }
-            case 't':
-                if (lexeme == "true") {
-                    return SyntaxToken(TrueKeywordToken, lexeme);
-                }
-                break;
-            case 'v':
-                if (lexeme == "var") {
-                    return SyntaxToken(VarKeywordToken, lexeme);
-                }
-                break;
-            case 'w':
-                if (lexeme == "while") {
-                    return SyntaxToken(WhileKeywordToken, lexeme);
-                }
+            return SyntaxToken(IdentifierToken, interner.intern(lexeme));
         }
-        return SyntaxToken(IdentifierToken, lexeme);
+        return SyntaxToken(keyword, start);
     }
     else
     {
@@ -121,60 +61,61 @@ SyntaxToken Lexer::lex()
         switch (current)
         {
             case '+':
-                return SyntaxToken(AddToken, "+");
+                return SyntaxToken(AddToken, start);
             case '-':
-                return SyntaxToken(MinusToken, "-");
+                return SyntaxToken(MinusToken, start);
             case '*':
-                return SyntaxToken(MultToken, "*");
+                return SyntaxToken(MultToken, start);
             case '/':
-                return SyntaxToken(DivideToken, "/");
+                return SyntaxToken(DivideToken, start);
             case '=':
                 if (getCurrentChar() == '=')
                 {
                     advance();
-                    return SyntaxToken(EqualsToken, "==");
+                    return SyntaxToken(EqualsToken, start);
                 }
-                return SyntaxToken(AssignmentToken, "=");
+                return SyntaxToken(AssignmentToken, start);
             case '(':
-                return SyntaxToken(LeftParenthesisToken, "(");
+                return SyntaxToken(LeftParenthesisToken, start);
             case ')':
-                return SyntaxToken(RightParenthesisToken, ")");
+                return SyntaxToken(RightParenthesisToken, start);
             case '{':
-                return SyntaxToken(LeftCurlyBraceToken, "{");
+                return SyntaxToken(LeftCurlyBraceToken, start);
             case '}':
-                return SyntaxToken(RightCurlyBraceToken, "}");
+                return SyntaxToken(RightCurlyBraceToken, start);
             case '"':
-                start = position - 1;
-                while (getCurrentChar() != '"') { advance(); }
+                position = CharScanner::findQuote(text.data(), position, text.size());
+                if (position >= text.size())
+                {
+                    return fail(start);
+                }
                 advance();
-                length = position - start;
-                lexeme = text.substr(start, length);
-                return SyntaxToken(StringLiteralToken, lexeme);
+                return SyntaxToken(StringLiteralToken, start);
             case ',':
-                return SyntaxToken(CommaToken, ",");
+                return SyntaxToken(CommaToken, start);
             case ';':
-                return SyntaxToken(SemicolonToken, ";");
+                return SyntaxToken(SemicolonToken, start);
             case '<':
                 if (getCurrentChar() == '=')
                 {
                     advance();
-                    return SyntaxToken(LessThanOrEqualToToken, "<=");
+                    return SyntaxToken(LessThanOrEqualToToken, start);
                 }
-                return SyntaxToken(LessThanToken, "<");
+                return SyntaxToken(LessThanToken, start);
             case '>':
                 if (getCurrentChar() == '=')
                 {
                     advance();
-                    return SyntaxToken(GreaterThanOrEqualToToken, ">=");
+                    return SyntaxToken(GreaterThanOrEqualToToken, start);
                 }
-                return SyntaxToken(GreaterThanToken, ">");
+                return SyntaxToken(GreaterThanToken, start);
             case '&':
                 if (getCurrentChar() == '&')
                 {
                     advance();
-                    return SyntaxToken(LogicalAndToken, "&&");
+                    return SyntaxToken(LogicalAndToken, start);
                 }
-                return SyntaxToken(BitwiseAndToken, "&&");
+                return SyntaxToken(BitwiseAndToken, start);
                 break;
             case '|':
                 if (!hasReachedEOF())
@@ -182,19 +123,96 @@ SyntaxToken Lexer::lex()
                     if (getCurrentChar() == '|')
                     {
                         advance();
-                        return SyntaxToken(LogicalOrToken, "||");
+                        return SyntaxToken(LogicalOrToken, start);
                     }
                 }
-                return SyntaxToken(BitwiseOrToken, "||");
+                return SyntaxToken(BitwiseOrToken, start);
                 break;
             case '\0':
-                return SyntaxToken(EOFToken, "EOF");
+                return SyntaxToken(EOFToken, start);
             default:
-                exit(EXIT_FAILURE);
+                return fail(start);
         }
     }
 };
 
+/**
+ * Ends the token stream with an error token for the lexeme at start. Every
+ * later call returns EOF, so the lexer can run on its own thread and leave
+ * reporting the error to whoever consumes its tokens.
+ */
+SyntaxToken Lexer::fail(uint32_t start)
+{
+    position = text.size() + 1;
+    return SyntaxToken(ErrorToken, start);
+}
+
+/**
+ * Returns false if the source file could not be opened
+ */
+bool Lexer::hasSource()
+{
+    return file.isOpen();
+}
+
+/**
+ * Describes why an error token could not be lexed
+ */
+std::string Lexer::getErrorMessage(SyntaxToken token)
+{
+    char current = text[token.getOffset()];
+    if (current == '"')
+    {
+        return "Unterminated string literal.";
+    }
+    return std::string("Unexpected character '") + current + "'.";
+}
+
+/**
+ * Recovers the text of a token from the source
+ */
+std::string_view Lexer::getText(SyntaxToken token)
+{
+    size_t start = token.getOffset(), end = start;
+    switch (token.getSyntaxType())
+    {
+        case EOFToken:
+            return "EOF";
+        case IntegerLiteralToken:
+            end = CharScanner::skipDigits(text.data(), end, text.size());
+            break;
+        case IdentifierToken:
+            return interner.getText(token.getSymbol());
+        case VarKeywordToken:
+        case IntKeywordToken:
+        case BoolKeywordToken:
+        case TrueKeywordToken:
+        case FalseKeywordToken:
+        case DoubleKeywordToken:
+        case ReturnKeyword:
+        case WhileKeywordToken:
+        case IfToken:
+        case ElseToken:
+        case PrintToken:
+            end = CharScanner::skipLetters(text.data(), end, text.size());
+            break;
+        case StringLiteralToken:
+            end = CharScanner::findQuote(text.data(), end + 1, text.size()) + 1;
+            break;
+        case EqualsToken:
+        case LessThanOrEqualToToken:
+        case GreaterThanOrEqualToToken:
+        case LogicalAndToken:
+        case LogicalOrToken:
+            end += 2;
+            break;
+        default:
+            end++;
+            break;
+    }
+    return text.substr(start, end - start);
+}
+
 /**
  * Retrieves the current character
  */
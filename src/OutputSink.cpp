@@ -0,0 +1,116 @@
+#include "../include/OutputSink.h"
+#include <algorithm>
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+void BufferSink::reserve(size_t size)
+{
+    size_t used = cursor - buffer.data();
+    buffer.resize(std::max({ used + size, buffer.size() * 2, (size_t)4096 }));
+    cursor = buffer.data() + used;
+    limit = buffer.data() + buffer.size();
+}
+
+/**
+ * Returns everything written so far
+ */
+std::string_view BufferSink::getText() const
+{
+    return std::string_view(buffer.data(), cursor - buffer.data());
+}
+
+/**
+ * Flushes the current block to make room. A write larger than a block gets
+ * a block of its own size.
+ */
+void FileSink::reserve(size_t size)
+{
+    flush();
+    if (size > buffer.size())
+    {
+        buffer.resize(size);
+        cursor = buffer.data();
+        limit = buffer.data() + buffer.size();
+    }
+}
+
+#ifdef _WIN32
+FileSink::FileSink(const std::string& path) : buffer(BlockSize), path(path)
+{
+    this->cursor = buffer.data();
+    this->limit = buffer.data() + buffer.size();
+    HANDLE file = CreateFileA(path.c_str(), GENERIC_WRITE, 0, nullptr, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE)
+    {
+        error = "Error: Could not open \"" + path + "\".";
+        return;
+    }
+    this->fileHandle = file;
+}
+
+FileSink::~FileSink()
+{
+    flush();
+    if (fileHandle)
+    {
+        CloseHandle(fileHandle);
+    }
+}
+
+void FileSink::flush()
+{
+    const char* data = buffer.data();
+    while (data < cursor && error.empty())
+    {
+        DWORD written;
+        if (!WriteFile(fileHandle, data, (DWORD)std::min<size_t>(cursor - data, 1u << 30), &written, nullptr))
+        {
+            error = "Error: Could not write \"" + path + "\".";
+            break;
+        }
+        data += written;
+    }
+    cursor = buffer.data();
+}
+#else
+FileSink::FileSink(const std::string& path) : buffer(BlockSize), path(path)
+{
+    this->cursor = buffer.data();
+    this->limit = buffer.data() + buffer.size();
+    fd = open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0)
+    {
+        error = "Error: Could not open \"" + path + "\".";
+    }
+}
+
+FileSink::~FileSink()
+{
+    flush();
+    if (fd >= 0)
+    {
+        close(fd);
+    }
+}
+
+void FileSink::flush()
+{
+    const char* data = buffer.data();
+    while (data < cursor && error.empty())
+    {
+        ssize_t written = ::write(fd, data, cursor - data);
+        if (written < 0)
+        {
+            error = "Error: Could not write \"" + path + "\".";
+            break;
+        }
+        data += written;
+    }
+    cursor = buffer.data();
+}
+#endif
@@ -1,5 +1,7 @@
+#include <charconv>
 #include <iostream>
 #include <vector>
+#include <utility>
 #include "../include/Parser.h"
 #include "../include/BinaryOperatorNode.h"
 #include "../include/IntegerLiteralNode.h"
@@ -8,37 +10,32 @@
 #include "../include/BooleanLiteralNode.h"
 #include "../include/IfStatementNode.h"
 #include "../include/VariableNode.h"
-#include "../include/ScopeTreeNode.h"
+#include "../include/ScopedSymbolTable.h"
 #include "../include/ReturnNode.h"
 #include "../include/TypeCheckingVisitor.h"
 #include "../include/FunctionDeclarationNode.h"
 #include "../include/FunctionCallNode.h"
 #include "../include/WhileNode.h"
 #include "../include/ProgramNode.h"
-#include "../include/StringSymbolTable.h"
 #include "../include/StringLiteralNode.h"
+#include "../include/BindingResolver.h"
 
 /**
- * Constructor
+ * Constructor. If isPipelined is set, the lexer runs on its own thread and
+ * feeds the parser through a lock-free queue.
  */
-Parser::Parser(std::string text) : lexer{ text }
+Parser::Parser(std::string text, bool isPipelined) : path{ text }, printfSymbol{ interner.intern("printf") }, lexer{ text, interner }, tokens{ lexer, isPipelined }
 {
-    //Perform Lexical Analysis
-    while (!lexer.hasReachedEOF())
-    {
-        tokens.push_back(lexer.lex());
-    }
-
-    ///Push the Global Scope Symbol Table
-    scopeTreeStack.push(new ScopeTreeNode());
-    auto printfNode = new FunctionDeclarationNode(IntegerPrimitive, "printf");
-    scopeTreeStack.top()->addEntry("printf", IntegerPrimitive, printfNode, true);
+    //Functions are declared in the global scope, which is never popped
+    auto printfNode = arena.create<FunctionDeclarationNode>(IntegerPrimitive, interner.getText(printfSymbol));
+    printfNode->functionSymbol = printfSymbol;
+    symbols.declare(printfSymbol, printfNode);
 };
 
 /**
  * Returns true if the passed Syntax Type is a binary operator
  */
-bool Parser::isBinaryOperator(SyntaxType syntaxType)
+constexpr bool Parser::isBinaryOperator(SyntaxType syntaxType)
 {
     switch (syntaxType)
     {
@@ -64,20 +61,29 @@ bool Parser::isBinaryOperator(SyntaxType syntaxType)
  */
 void Parser::printTokens()
 {
+    //Lex the file separately so the parser's own token window is untouched
+    Interner printInterner;
+    Lexer printLexer(path, printInterner);
     std::cout << "Printing Tokens...\n";
-    for (auto& x : tokens)
+    while (!printLexer.hasReachedEOF())
     {
-        std::cout << x.getText() << "\n";
+        auto x = printLexer.lex();
+        std::cout << printLexer.getText(x) << "\n";
     }
 };
 
 /**
- * Looks ahead in the token table by an offset
+ * Looks ahead in the token window by an offset, reporting a lexical error as
+ * soon as the parser reaches it
  */
 SyntaxToken Parser::peek(int offset)
 {
-    auto index = position + offset;
-    return tokens[index];
+    auto token = tokens.peek(offset);
+    if (token.getSyntaxType() == ErrorToken)
+    {
+        fail("Error: " + lexer.getErrorMessage(token));
+    }
+    return token;
 };
 
 /**
@@ -94,7 +100,7 @@ SyntaxToken Parser::getCurrentToken()
 SyntaxToken Parser::getNextToken()
 {
     auto current = getCurrentToken();
-    position++;
+    tokens.advance();
     return current;
 };
 
@@ -108,14 +114,10 @@ SyntaxToken Parser::match(SyntaxType expected, std::string text)
     {
         return getNextToken();
     }
-    else
-    {
-        std::cerr << "Unexpected Token \"" << current.getText() << "\". Expected " << text << ".";
-    }
-    exit(EXIT_FAILURE);
+    fail("Unexpected Token \"" + std::string(lexer.getText(current)) + "\". Expected " + text + ".");
 };
 
-int Parser::getOperatorPrecedence(SyntaxType op)
+constexpr int Parser::getOperatorPrecedence(SyntaxType op)
 {
     switch (op)
     {
@@ -142,6 +144,11 @@ int Parser::getOperatorPrecedence(SyntaxType op)
     return 0;
 }
 
+constexpr bool Parser::isRightAssociative(SyntaxType op)
+{
+    return op == AssignmentToken;
+}
+
 BinaryOperatorType Parser::getBinaryOperatorType(SyntaxType op)
 {
     switch (op)
@@ -171,192 +178,338 @@ BinaryOperatorType Parser::getBinaryOperatorType(SyntaxType op)
         case EqualsToken:
             return EqualsOperator;
         default:
-            std::cout << "TEST";
-            exit(EXIT_FAILURE);
+            fail("Error: Unsupported binary operator.");
     }
 };
 
 /**
- * Parses tokens such as literals and function calls.
+ * Parses tokens such as literals and identifiers. Parentheses and the
+ * argument lists of function calls are handled by parseExpression.
  */
 ASTNode* Parser::parsePrimary()
 {
-    std::string result;
-    ASTNode* tree;
-    std::string identifier, text;
+    std::string_view identifier, digits;
+    std::string text;
+    Symbol symbol;
     ASTNode* varNode;
-    std::vector<ASTNode*> args;
+    int value;
     switch (getCurrentToken().getSyntaxType())
     {
         case IntegerLiteralToken:
-            result = match(IntegerLiteralToken, "Integer Literal").getText();
-            return new IntegerLiteralNode(std::stoi(result));
+            digits = lexer.getText(match(IntegerLiteralToken, "Integer Literal"));
+            if (std::from_chars(digits.data(), digits.data() + digits.size(), value).ec != std::errc())
+            {
+                fail("Integer literal \"" + std::string(digits) + "\" is too large.");
+            }
+            return arena.create<IntegerLiteralNode>(value);
         case TrueKeywordToken:
             match(TrueKeywordToken, "true");
-            return new BooleanLiteralNode(true);
+            return arena.create<BooleanLiteralNode>(true);
         case FalseKeywordToken:
             match(FalseKeywordToken, "false");
-            return new BooleanLiteralNode(false);
-        case LeftParenthesisToken:
-            match(LeftParenthesisToken, "(");
-            tree = parseExpression(0);
-            match(RightParenthesisToken, ")");
-            return tree;
+            return arena.create<BooleanLiteralNode>(false);
         case IdentifierToken:
-            identifier = getCurrentToken().getText();
-            match(IdentifierToken, "identifier");
+            symbol = match(IdentifierToken, "identifier").getSymbol();
+            identifier = interner.getText(symbol);
             /**
              * Attempt to find the local variable node corresponding to the given identifier.
              * If it is found, return the node. Otherwise, report an error
              */
-            varNode = resolve(identifier, scopeTreeStack.top());
+            varNode = symbols.lookup(symbol);
             if (varNode)
             {
-                std::cout << "Identifier: " << identifier << " was found\n";
-                if (getCurrentToken().getSyntaxType() == LeftParenthesisToken)
-                {
-                    match(LeftParenthesisToken, "(");
-                    if (getCurrentToken().getSyntaxType() != RightParenthesisToken)
-                    {
-                        args.push_back(parseExpression(0));
-                    }
-                    while (getCurrentToken().getSyntaxType() != RightParenthesisToken)
-                    {
-                        match(CommaToken, ",");
-                        args.push_back(parseExpression(0));
-                    }
-                    match(RightParenthesisToken, ")");
-                    return new FunctionCallNode(identifier, args);
-                }
                 return varNode;
             }
-            else
-            {
-                std::cerr << "Variable \"" << identifier << "\" does not exist in the current scope";
-                exit(EXIT_FAILURE);
-            }
+            fail("Variable \"" + std::string(identifier) + "\" does not exist in the current scope");
         case StringLiteralToken:
-            text = match(StringLiteralToken, "String literal").getText();
-            StringSymbolTable::addEntry(text);
-            return new StringLiteralNode(text);
+            text = lexer.getText(match(StringLiteralToken, "String literal"));
+            return arena.create<StringLiteralNode>(text, strings.add(text));
 
         default:
             match(IntegerLiteralToken, "Integer Literal");
-            exit(EXIT_FAILURE);
+            break;
     }
     return nullptr;
 };
 
 /**
- * Construct an AST via precendence climbing parsing
+ * Precedence and associativity of every token kind, built at compile time
+ * from getOperatorPrecedence, isRightAssociative and isBinaryOperator
  */
-ASTNode* Parser::parseExpression(int minimumPrecedence)
+struct Parser::OperatorTable
 {
-    ASTNode* left = parsePrimary(), * right, * ltemp;
-    SyntaxType lookAhead = getCurrentToken().getSyntaxType();
+    //ErrorToken is the last token kind
+    static constexpr int Size = ErrorToken + 1;
+    int precedence[Size] = {};
+    bool isBinary[Size] = {};
+    bool isRightAssociative[Size] = {};
+
+    constexpr OperatorTable()
+    {
+        for (int i = 0; i < Size; i++)
+        {
+            SyntaxType type = (SyntaxType)i;
+            precedence[i] = Parser::getOperatorPrecedence(type);
+            isBinary[i] = Parser::isBinaryOperator(type);
+            isRightAssociative[i] = Parser::isRightAssociative(type);
+        }
+    }
+};
 
-    while ((isBinaryOperator(lookAhead) && getOperatorPrecedence(lookAhead) > minimumPrecedence)
-        || (isRightAssociative(lookAhead) && getOperatorPrecedence(lookAhead) == minimumPrecedence)) {
-        getNextToken();
-        right = parseExpression(getOperatorPrecedence(lookAhead));
+/**
+ * Construct an AST with the shunting-yard algorithm. Pending operators,
+ * parentheses and the argument lists of calls wait on explicit stacks rather
+ * than on the call stack, so long operator chains and deep nesting do not
+ * recurse. The trees are the same ones precedence climbing builds.
+ */
+ASTNode* Parser::parseExpression()
+{
+    static constexpr OperatorTable table{};
+
+    struct PendingCall
+    {
+        Symbol symbol;
+        size_t firstArgument;
+    };
+
+    //Besides binary operators, this holds a LeftParenthesisToken for each open
+    //parenthesis and an IdentifierToken for each open argument list
+    std::vector<SyntaxType> operators;
+    std::vector<ASTNode*> operands;
+    std::vector<PendingCall> calls;
+    bool isOperandNext = true;
+
+    auto reduce = [&]()
+    {
+        SyntaxType op = operators.back();
+        operators.pop_back();
+        ASTNode* right = operands.back();
+        operands.pop_back();
+        ASTNode* left = operands.back();
 
         /**
          * This ensures that the left hand side of the tree is loaded into a register,
          * and the right hand side is simply retrieved from RAM when generating the
          * x86-64 code.
          */
-        if (lookAhead == AssignmentToken)
+        if (op == AssignmentToken)
+        {
+            std::swap(left, right);
+        }
+        operands.back() = arena.create<BinaryOperatorNode>(left, getBinaryOperatorType(op), right);
+    };
+
+    while (true)
+    {
+        SyntaxType lookAhead = getCurrentToken().getSyntaxType();
+        if (isOperandNext)
+        {
+            if (lookAhead == LeftParenthesisToken)
+            {
+                match(LeftParenthesisToken, "(");
+                operators.push_back(LeftParenthesisToken);
+                continue;
+            }
+            Symbol symbol = getCurrentToken().getSymbol();
+            ASTNode* operand = parsePrimary();
+            if (lookAhead == IdentifierToken && getCurrentToken().getSyntaxType() == LeftParenthesisToken)
+            {
+                match(LeftParenthesisToken, "(");
+                if (getCurrentToken().getSyntaxType() != RightParenthesisToken)
+                {
+                    calls.push_back({ symbol, operands.size() });
+                    operators.push_back(IdentifierToken);
+                    continue;
+                }
+                match(RightParenthesisToken, ")");
+                operand = arena.create<FunctionCallNode>(symbol, interner.getText(symbol), std::vector<ASTNode*>{});
+            }
+            operands.push_back(operand);
+            isOperandNext = false;
+            continue;
+        }
+
+        if (table.isBinary[lookAhead])
         {
-            ltemp = left;
-            left = right;
-            right = ltemp;
+            int precedence = table.precedence[lookAhead];
+            while (!operators.empty() && table.isBinary[operators.back()]
+                && (table.precedence[operators.back()] > precedence
+                    || (table.precedence[operators.back()] == precedence && !table.isRightAssociative[lookAhead])))
+            {
+                reduce();
+            }
+            getNextToken();
+            operators.push_back(lookAhead);
+            isOperandNext = true;
+            continue;
         }
 
-        left = new BinaryOperatorNode(left, getBinaryOperatorType(lookAhead), right);
-        lookAhead = getCurrentToken().getSyntaxType();
-        if (lookAhead == RightParenthesisToken || lookAhead == SemicolonToken)
+        //Anything else closes the innermost open group, or ends the expression
+        while (!operators.empty() && table.isBinary[operators.back()])
+        {
+            reduce();
+        }
+        if (operators.empty())
+        {
+            return operands.back();
+        }
+        if (operators.back() == LeftParenthesisToken)
+        {
+            match(RightParenthesisToken, ")");
+            operators.pop_back();
+            continue;
+        }
+        if (lookAhead != RightParenthesisToken)
         {
-            return left;
+            match(CommaToken, ",");
+            isOperandNext = true;
+            continue;
         }
+        match(RightParenthesisToken, ")");
+        PendingCall call = calls.back();
+        calls.pop_back();
+        operators.pop_back();
+        std::vector<ASTNode*> args(operands.begin() + call.firstArgument, operands.end());
+        operands.resize(call.firstArgument);
+        operands.push_back(arena.create<FunctionCallNode>(call.symbol, interner.getText(call.symbol), std::move(args)));
     }
-    return left;
 };
 
+/**
+ * Parses one statement. Blocks, ifs and whiles that are still waiting for
+ * their bodies wait on an explicit stack rather than on the call stack, so
+ * statements can nest to any depth. Each finished statement is handed to the
+ * innermost one waiting, which may be finished by it in turn.
+ */
 ASTNode* Parser::parseStatement()
 {
-    switch (getCurrentToken().getSyntaxType())
+    struct PendingStatement
     {
-        case IfToken:
-            return parseIfStatement();
-        case LeftCurlyBraceToken:
-            return parseCompoundStatement();
-        case VarKeywordToken:
-        case IntKeywordToken:
-        case BoolKeywordToken:
-            return parseVariableDeclarationStatement();
-        case ReturnKeyword:
-            return parseReturnStatement();
-        case WhileKeywordToken:
-            return parseWhileStatement();
-        default:
-            return parseExpressionStatement();
-    }
-    return nullptr;
-}
-
-ASTNode* Parser::parseCompoundStatement()
-{
-    match(LeftCurlyBraceToken, "{");
-    std::vector<ASTNode*> statements;
+        //CompoundStatementKind, IfStatementKind or WhileKind
+        NodeKind kind;
+        ASTNode* condition;
+        //The "then" portion of an if, once it has been parsed
+        ASTNode* body;
+        //Where the block's statements start in blockStatements
+        size_t firstStatement;
+    };
+    std::vector<PendingStatement> pending;
+    std::vector<ASTNode*> blockStatements;
+
+    while (true)
+    {
+        ASTNode* statement = nullptr;
+        switch (getCurrentToken().getSyntaxType())
+        {
+            case IfToken:
+            {
+                //Parse the "if (condition)" portion; the body is the next statement
+                match(IfToken, "if");
+                match(LeftParenthesisToken, "(");
+                ASTNode* condition = parseExpression();
+                match(RightParenthesisToken, ")");
+                pending.push_back({ IfStatementKind, condition, nullptr, 0 });
+                continue;
+            }
+            case WhileKeywordToken:
+            {
+                //Parse the "while (condition)" portion; the body is the next statement
+                match(WhileKeywordToken, "while");
+                match(LeftParenthesisToken, "(");
+                ASTNode* condition = parseExpression();
+                match(RightParenthesisToken, ")");
+                pending.push_back({ WhileKind, condition, nullptr, 0 });
+                continue;
+            }
+            case LeftCurlyBraceToken:
+                match(LeftCurlyBraceToken, "{");
 
-    /**
-     * When we encounter a block statement, we push a new scope onto the stack,
-     * make it the child of the parent to resolve variables in nested scopes,
-     * and increment the scope variable.
-     */
-    ScopeTreeNode* parent = scopeTreeStack.top(), * child = new ScopeTreeNode();
-    scopeTreeStack.push(child);
-    parent->addChild(child);
-    scope++;
+                //When we encounter a block statement, we open a new scope for its locals
+                symbols.pushScope();
+                if (getCurrentToken().getSyntaxType() != RightCurlyBraceToken)
+                {
+                    pending.push_back({ CompoundStatementKind, nullptr, nullptr, blockStatements.size() });
+                    continue;
+                }
+                match(RightCurlyBraceToken, "}");
+                symbols.popScope();
+                statement = arena.create<CompoundStatementNode>(std::vector<ASTNode*>());
+                break;
+            case VarKeywordToken:
+            case IntKeywordToken:
+            case BoolKeywordToken:
+                statement = parseVariableDeclarationStatement();
+                break;
+            case ReturnKeyword:
+                statement = parseReturnStatement();
+                break;
+            default:
+                statement = parseExpressionStatement();
+                break;
+        }
 
-    //While inside the compound statement
-    while (getCurrentToken().getSyntaxType() != RightCurlyBraceToken)
-    {
-        //Add each statement to the statement list
-        statements.push_back(parseStatement());
+        //Finish every statement that was only waiting on this one
+        bool isWaitingForStatement = false;
+        while (!isWaitingForStatement)
+        {
+            if (pending.empty())
+            {
+                return statement;
+            }
+            PendingStatement& top = pending.back();
+            switch (top.kind)
+            {
+                case CompoundStatementKind:
+                    blockStatements.push_back(statement);
+                    if (getCurrentToken().getSyntaxType() != RightCurlyBraceToken)
+                    {
+                        isWaitingForStatement = true;
+                        continue;
+                    }
+                    match(RightCurlyBraceToken, "}");
+
+                    //When the scope ends, its locals are no longer visible
+                    symbols.popScope();
+                    statement = arena.create<CompoundStatementNode>(std::vector<ASTNode*>(blockStatements.begin() + top.firstStatement, blockStatements.end()));
+                    blockStatements.resize(top.firstStatement);
+                    break;
+                case IfStatementKind:
+                    //An else belongs to the innermost if still waiting for one
+                    if (!top.body && getCurrentToken().getSyntaxType() == ElseToken)
+                    {
+                        match(ElseToken, "else");
+                        top.body = statement;
+                        isWaitingForStatement = true;
+                        continue;
+                    }
+                    statement = top.body ? arena.create<IfStatementNode>(top.condition, top.body, statement) : arena.create<IfStatementNode>(top.condition, statement, nullptr);
+                    break;
+                default:
+                    statement = arena.create<WhileNode>(top.condition, statement);
+                    break;
+            }
+            pending.pop_back();
+        }
     }
-    match(RightCurlyBraceToken, "}");
-
-    //When the scope ends, decrement the scope and pop the stack
-    scope--;
-    scopeTreeStack.pop();
-    return new CompoundStatementNode(statements);
 }
 
-ASTNode* Parser::parseIfStatement()
+/**
+ * Parses a block, such as a function body
+ */
+ASTNode* Parser::parseCompoundStatement()
 {
-    ASTNode* condition, * stmtBody, * elseBody = nullptr;
-
-    //Parse the "if (condition)" portion
-    match(IfToken, "if");
-    match(LeftParenthesisToken, "(");
-    condition = parseExpression(0);
-    match(RightParenthesisToken, ")");
-
-    //Parse the "then" portion of the if statement
-    stmtBody = parseStatement();
-    if (getCurrentToken().getSyntaxType() == ElseToken)
+    if (getCurrentToken().getSyntaxType() != LeftCurlyBraceToken)
     {
-        match(ElseToken, "else");
-        elseBody = parseStatement();
+        match(LeftCurlyBraceToken, "{");
     }
-    return new IfStatementNode(condition, stmtBody, elseBody);
+    return parseStatement();
 }
 
 ASTNode* Parser::parseVariableDeclarationStatement()
 {
     ASTNode* rhs = nullptr;
-    std::string identifier;
+    std::string_view identifier;
+    Symbol symbol;
     SyntaxToken token = getCurrentToken();
     bool isVarType = false;
     Type t;
@@ -366,7 +519,6 @@ ASTNode* Parser::parseVariableDeclarationStatement()
 
             match(IntKeywordToken, "int");
             t = IntegerPrimitive;
-            localOffset += 4;
             break;
         case DoubleKeywordToken:
             match(DoubleKeywordToken, "double");
@@ -383,26 +535,27 @@ ASTNode* Parser::parseVariableDeclarationStatement()
     }
     token = getCurrentToken();
     match(IdentifierToken, "an identifer");
-    identifier = token.getText();
+    symbol = token.getSymbol();
+    identifier = interner.getText(symbol);
 
     /**
      * Rather than checking the parent scope, we check the local scope
      * so that we can implement variable shadowing
      */
-    if (scopeTreeStack.top()->getNode(identifier))
+    if (symbols.isDeclaredInCurrentScope(symbol))
     {
-        std::cerr << "Error: Variable \"" << identifier << "\" already exists.\n";
-        exit(EXIT_FAILURE);
+        fail("Error: Variable \"" + std::string(identifier) + "\" already exists.");
     }
     //Add the local variable to the current scope
-    scopeTreeStack.top()->addEntry(identifier, t, new VariableNode(t, identifier, true), false);
+    VariableNode* variable = arena.create<VariableNode>(t, symbol, identifier, true);
+    symbols.declare(symbol, variable);
     token = getCurrentToken();
 
     //Implicitly typed variables require an assignment so as to deduce the type
     if (isVarType)
     {
         match(AssignmentToken, "=");
-        rhs = parseExpression(0);
+        rhs = parseExpression();
         match(SemicolonToken, ";");
     }
     else
@@ -414,20 +567,20 @@ ASTNode* Parser::parseVariableDeclarationStatement()
         else
         {
             match(AssignmentToken, "=");
-            rhs = parseExpression(0);
+            rhs = parseExpression();
             match(SemicolonToken, ";");
         }
     }
-    return new VariableDeclarationNode(scopeTreeStack.top()->getNode(identifier), rhs, identifier);
+    return arena.create<VariableDeclarationNode>(variable, rhs, symbol, identifier);
 }
 
 ASTNode* Parser::parseReturnStatement()
 {
     ASTNode* toReturn;
     match(ReturnKeyword, "return");
-    toReturn = parseExpression(0);
+    toReturn = parseExpression();
     match(SemicolonToken, ";");
-    return new ReturnNode(toReturn);
+    return arena.create<ReturnNode>(toReturn);
 }
 
 /**
@@ -438,7 +591,8 @@ ASTNode* Parser::parseFunctionDeclaration()
     Type returnType;
     ASTNode* body;
     FunctionDeclarationNode* functionDeclNode;
-    std::string functionIdentifier, parameterIdentifier;
+    std::string_view functionIdentifier, parameterIdentifier;
+    Symbol functionSymbol = 0, parameterSymbol;
     std::vector<std::pair<VariableDeclarationNode*, Type>> parameterList;
 
     //Determine the return type of the function
@@ -453,27 +607,24 @@ ASTNode* Parser::parseFunctionDeclaration()
             match(BoolKeywordToken, "bool");
             break;
         case VarKeywordToken:
-            std::cerr << "Error: \"var\" is not valid for function arguments.\n";
-            exit(EXIT_FAILURE);
+            fail("Error: \"var\" is not valid for function arguments.");
     }
 
     //Match and obtain the function identifier
     if (getCurrentToken().getSyntaxType() == IdentifierToken)
     {
-        functionIdentifier = getCurrentToken().getText();
+        functionSymbol = getCurrentToken().getSymbol();
+        functionIdentifier = interner.getText(functionSymbol);
     }
     match(IdentifierToken, "an identifier");
 
     /**
-     * When declaring a function, the parameters are made children of the global scope,
+     * When declaring a function, the parameters get a scope nested in the global scope,
      * and the function body adds a new scope to the scope in which the parameters reside.
     */
-    functionDeclNode = new FunctionDeclarationNode(returnType, functionIdentifier);
-    scopeTreeStack.top()->addEntry(functionIdentifier, returnType, functionDeclNode, true);
-    ScopeTreeNode* parent = scopeTreeStack.top(), * child = new ScopeTreeNode();
-    scopeTreeStack.push(child);
-    parent->addChild(child);
-    scope++;
+    functionDeclNode = arena.create<FunctionDeclarationNode>(returnType, functionIdentifier);
+    symbols.declare(functionSymbol, functionDeclNode);
+    symbols.pushScope();
 
     //Parse the function parameters (if any)
     match(LeftParenthesisToken, "(");
@@ -485,11 +636,12 @@ ASTNode* Parser::parseFunctionDeclaration()
          * Obtain the parameter identifier, add it to the current scope's symbol table,
          * and add it to the function's argument list
          */
-        parameterIdentifier = match(IdentifierToken, "an identifier").getText();
-        auto node = new VariableNode(IntegerPrimitive, parameterIdentifier, true);
-        parameterList.push_back(std::pair<VariableDeclarationNode*, Type>(new VariableDeclarationNode(node, nullptr, parameterIdentifier), IntegerPrimitive));
+        parameterSymbol = match(IdentifierToken, "an identifier").getSymbol();
+        parameterIdentifier = interner.getText(parameterSymbol);
+        auto node = arena.create<VariableNode>(IntegerPrimitive, parameterSymbol, parameterIdentifier, true);
+        parameterList.push_back(std::pair<VariableDeclarationNode*, Type>(arena.create<VariableDeclarationNode>(node, nullptr, parameterSymbol, parameterIdentifier), IntegerPrimitive));
 
-        scopeTreeStack.top()->addEntry(parameterIdentifier, IntegerPrimitive, node, true);
+        symbols.declare(parameterSymbol, node);
 
         /**
          * If a comma is encountered, the next token cannot be a right semicolon
@@ -500,8 +652,7 @@ ASTNode* Parser::parseFunctionDeclaration()
             //Ensure that the next token is NOT a right parenthesis
             if (getCurrentToken().getSyntaxType() == RightParenthesisToken)
             {
-                std::cerr << "Error: Invalid function declaration syntax";
-                exit(EXIT_FAILURE);
+                fail("Error: Invalid function declaration syntax");
             }
         }
     }
@@ -511,64 +662,66 @@ ASTNode* Parser::parseFunctionDeclaration()
     body = parseCompoundStatement();
     /**
      * At this point, the scope is returned to that of the function parameters,
-     * so we pop the stack and decrement the scope to return to the global scope for
-     * future function declarations
+     * so we pop it to return to the global scope for future function declarations
      */
-    scopeTreeStack.pop();
-    scope--;
+    symbols.popScope();
     functionDeclNode->functionBody = body;
-    functionDeclNode->parameterList = parameterList;
+    functionDeclNode->parameterList = std::move(parameterList);
     functionDeclNode->functionName = functionIdentifier;
-    functionDeclNode->stackOffset = (localOffset | 15) + 1;
-    localOffset = 0;
+    functionDeclNode->functionSymbol = functionSymbol;
     return functionDeclNode;
 }
 
 ASTNode* Parser::parseExpressionStatement()
 {
-    ASTNode* expr = parseExpression(0);
+    ASTNode* expr = parseExpression();
     match(SemicolonToken, ";");
     return expr;
 }
 
-ASTNode* Parser::parseWhileStatement()
+/**
+ * Parses the program from start to finish by parsing functions as well as
+ * global variable declarations.
+ */
+ASTNode* Parser::parseProgram()
 {
-    ASTNode* condition, * body;
-
-    //Parse the "while (condition)" portion
-    match(WhileKeywordToken, "while");
-    match(LeftParenthesisToken, "(");
-    condition = parseExpression(0);
-    match(RightParenthesisToken, ")");
-    body = parseStatement();
-    return new WhileNode(condition, body);
-
-}
+    if (!lexer.hasSource())
+    {
+        errors.push_back("Error: Could not open \"" + path + "\".");
+        return nullptr;
+    }
+    std::vector<ASTNode*> units;
+    try
+    {
+        //While there are still tokens to be read in
+        while (getCurrentToken().getSyntaxType() != EOFToken)
+        {
+            units.push_back(parseFunctionDeclaration());
+        }
+    }
+    catch (const SyntaxError& error)
+    {
+        errors.push_back(error.message);
+        return nullptr;
+    }
+    ProgramNode* program = arena.create<ProgramNode>(std::move(units), std::move(strings));
 
-ASTNode* Parser::resolve(std::string identifier, ScopeTreeNode* node)
-{
-    if (!node) { return nullptr; }
-    auto variableNode = node->getNode(identifier);
-    if (!variableNode) { return resolve(identifier, node->getParentNode()); }
-    else { return variableNode; }
+    //Assign frame slots now so that every tree handed out is ready for codegen
+    BindingResolver resolver;
+    resolver.resolve(program);
+    return program;
 }
 
-bool Parser::isRightAssociative(SyntaxType op)
+const std::vector<std::string>& Parser::getErrors()
 {
-    return op == AssignmentToken;
+    return errors;
 }
 
 /**
- * Parses the program from start to finish by parsing functions as well as
- * global variable declarations.
+ * Abandons the parse. Errors are returned to the caller rather than ending
+ * the process, since other files may be compiling on other threads.
  */
-ASTNode* Parser::parseProgram()
+void Parser::fail(const std::string& message)
 {
-    std::vector<ASTNode*> units;
-    //While there are still tokens to be read in
-    while (getCurrentToken().getSyntaxType() != EOFToken)
-    {
-        units.push_back(parseFunctionDeclaration());
-    }
-    return new ProgramNode(units);
+    throw SyntaxError{ message };
 }
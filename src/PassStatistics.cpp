@@ -0,0 +1,14 @@
+#include "../include/PassStatistics.h"
+#include "../include/OutputSink.h"
+
+/**
+ * Writes one line per pass, in the order the passes run
+ */
+void PassStatistics::print(OutputSink& out) const
+{
+    out << "constant propagation: " << foldedInstructions.load() << " instructions folded, "
+        << prunedBranches.load() << " branches pruned\n";
+    out << "dead code elimination: " << removedInstructions.load() << " instructions, "
+        << removedBlocks.load() << " blocks removed\n";
+    out << "global value numbering: " << eliminatedComputations.load() << " redundant computations eliminated\n";
+}
@@ -1,18 +1,18 @@
 #include "../include/BinaryOperatorNode.h"
-#include "../include/CompoundStatementnode.h"
-#include "../include/IfStatementnode.h"
+#include "../include/CompoundStatementNode.h"
+#include "../include/IfStatementNode.h"
 #include "../include/IntegerLiteralNode.h"
 #include "../include/PrintVisitor.h"
-#include "../include/VariableDeclarationnode.h"
-#include "../include/BooleanLiteralnode.h"
+#include "../include/VariableDeclarationNode.h"
+#include "../include/BooleanLiteralNode.h"
 #include "../include/Visitor.h"
-#include "../include/Variablenode.h"
+#include "../include/VariableNode.h"
 #include "../include/FunctionDeclarationNode.h"
-#include "../include/FunctionCallnode.h"
+#include "../include/FunctionCallNode.h"
 
-#include "../include/Returnnode.h"
-#include "../include/Programnode.h"
-#include "../include/Returnnode.h"
+#include "../include/ReturnNode.h"
+#include "../include/ProgramNode.h"
+#include "../include/ReturnNode.h"
 
 #include "../include/Type.h"
 #include <iostream>
@@ -30,11 +30,11 @@ void PrintVisitor::visitBinaryOperatorNode(BinaryOperatorNode* node)
 
     if (node->op != AssignmentOperator)
     {
-        node->left->accept(*this);
+        visit(node->left);
     }
     else
     {
-        node->right->accept(*this);
+        visit(node->right);
     }
     switch (node->op)
     {
@@ -60,11 +60,11 @@ void PrintVisitor::visitBinaryOperatorNode(BinaryOperatorNode* node)
     }
     if (node->op != AssignmentOperator)
     {
-        node->right->accept(*this);
+        visit(node->right);
     }
     else
     {
-        node->left->accept(*this);
+        visit(node->left);
     }
 
 }
@@ -83,7 +83,7 @@ void PrintVisitor::visitCompoundStatementNode(CompoundStatementNode* node)
     for (auto& statement : node->getStatements())
     {
         printIndent();
-        statement->accept(*this);
+        visit(statement);
         std::cout << ";\n";
     }
     indentation -= 4;
@@ -95,17 +95,17 @@ void PrintVisitor::visitCompoundStatementNode(CompoundStatementNode* node)
 void PrintVisitor::visitIfStatementNode(IfStatementNode* node)
 {
     std::cout << "if (";
-    node->getCondition()->accept(*this);
+    visit(node->getCondition());
     std::cout << ")";
-    node->getIfStmtBody()->accept(*this);
+    visit(node->getIfStmtBody());
 }
 
 void PrintVisitor::visitVariableDeclarationNode(VariableDeclarationNode* node)
 {
     std::cout << "int ";
-    node->getVarNode()->accept(*this);
+    visit(node->getVarNode());
     std::cout << " = ";
-    node->getRHS()->accept(*this);
+    visit(node->getRHS());
 }
 
 void PrintVisitor::visitBooleanLiteralNode(BooleanLiteralNode* node)
@@ -122,14 +122,14 @@ void PrintVisitor::visitFunctionDeclarationNode(FunctionDeclarationNode* node)
     std::cout << "int ";
     std::cout << node->getFunctionName();
     std::cout << "()";
-    node->getFunctionBody()->accept(*this);
+    visit(node->getFunctionBody());
     return;
 }
 
 void PrintVisitor::visitReturnNode(ReturnNode* node)
 {
     std::cout << "return ";
-    node->toReturn->accept(*this);
+    visit(node->toReturn);
 }
 
 void PrintVisitor::visitFunctionCallNode(FunctionCallNode* node)
@@ -141,7 +141,7 @@ void PrintVisitor::visitProgramNode(ProgramNode* node)
 {
     for (const auto& programUnit : node->getProgramUnits())
     {
-        programUnit->accept(*this);
+        visit(programUnit);
     }
 }
 
@@ -1,11 +1,20 @@
 #include "../include/ProgramNode.h"
 #include "../include/Visitor.h"
+#include <utility>
 
-ProgramNode::ProgramNode(std::vector<ASTNode*> list) : programUnits{ list } {};
+ProgramNode::ProgramNode(std::vector<ASTNode*> list, StringPool strings) : ASTNode(ProgramKind), programUnits{ std::move(list) }, strings{ std::move(strings) } {};
 
-std::vector<ASTNode*> ProgramNode::getProgramUnits()
+Span<ASTNode*> ProgramNode::getProgramUnits()
 {
-    return programUnits;
+    return Span<ASTNode*>(programUnits.data(), programUnits.size());
+}
+
+/**
+ * Returns the string literals used anywhere in the program
+ */
+const StringPool& ProgramNode::getStrings()
+{
+    return this->strings;
 }
 
 void ProgramNode::accept(Visitor& v)
@@ -0,0 +1,224 @@
+#include "../include/RegisterAllocator.h"
+#include <algorithm>
+
+RegisterAllocator::RegisterAllocator(int registerCount, int preservedCount) : registerCount{ registerCount }, preservedCount{ preservedCount } {}
+
+void RegisterAllocator::allocate(const TACFunction& function)
+{
+    uint32_t count = function.registerCount;
+    intervals.assign(count, { UINT32_MAX, 0 });
+    assignments.assign(count, Spilled);
+    spillSlots.assign(count, 0);
+    callPositions.clear();
+    spillSlotCount = 0;
+    usedRegisters = 0;
+    computeIntervals(function);
+
+    std::vector<VirtualRegister> order;
+    for (VirtualRegister reg = 0; reg < count; reg++)
+    {
+        if (intervals[reg].start != UINT32_MAX)
+        {
+            order.push_back(reg);
+        }
+    }
+    std::sort(order.begin(), order.end(), [&](VirtualRegister left, VirtualRegister right)
+    {
+        return intervals[left].start < intervals[right].start;
+    });
+
+    uint32_t allRegisters = (1u << registerCount) - 1, preservedRegisters = (1u << preservedCount) - 1;
+    uint32_t freeRegisters = allRegisters;
+    std::vector<VirtualRegister> active;
+    for (VirtualRegister reg : order)
+    {
+        const Interval& interval = intervals[reg];
+
+        size_t kept = 0;
+        for (VirtualRegister other : active)
+        {
+            if (intervals[other].end < interval.start)
+            {
+                freeRegisters |= 1u << assignments[other];
+            }
+            else
+            {
+                active[kept++] = other;
+            }
+        }
+        active.resize(kept);
+
+        uint32_t allowed = isLiveAcrossCall(interval) ? preservedRegisters : allRegisters;
+        uint32_t candidates = freeRegisters & allowed;
+        if (candidates)
+        {
+            //Prefer a register that does not have to be saved in the prologue
+            uint32_t unpreserved = candidates & ~preservedRegisters;
+            uint32_t choices = unpreserved ? unpreserved : candidates;
+            int chosen = 0;
+            while (!((choices >> chosen) & 1))
+            {
+                chosen++;
+            }
+            assignments[reg] = chosen;
+            freeRegisters &= ~(1u << chosen);
+            usedRegisters |= 1u << chosen;
+            active.push_back(reg);
+            continue;
+        }
+
+        //Nothing is free, so whichever of this and the active intervals ends last goes to memory
+        VirtualRegister victim = NoRegister;
+        for (VirtualRegister other : active)
+        {
+            if ((allowed >> assignments[other]) & 1 && (victim == NoRegister || intervals[other].end > intervals[victim].end))
+            {
+                victim = other;
+            }
+        }
+        if (victim != NoRegister && intervals[victim].end > interval.end)
+        {
+            assignments[reg] = assignments[victim];
+            spill(victim);
+            std::replace(active.begin(), active.end(), victim, reg);
+        }
+        else
+        {
+            spill(reg);
+        }
+    }
+}
+
+int RegisterAllocator::getRegister(VirtualRegister reg) const
+{
+    return assignments[reg];
+}
+
+uint32_t RegisterAllocator::getSpillSlot(VirtualRegister reg) const
+{
+    return spillSlots[reg];
+}
+
+uint32_t RegisterAllocator::getSpillSlotCount() const
+{
+    return spillSlotCount;
+}
+
+/**
+ * Returns a mask of the machine registers that were handed out
+ */
+uint32_t RegisterAllocator::getUsedRegisters() const
+{
+    return usedRegisters;
+}
+
+/**
+ * Numbers the instructions in layout order and finds the interval of each
+ * register. Instruction i reads its operands at position 2i and writes its
+ * result at 2i + 1, so a register whose last use is an instruction can be
+ * reused for that instruction's result.
+ *
+ * A register is live into a block if it is used there before being
+ * defined, and from there it is live out of each predecessor and into each
+ * predecessor that does not define it, walking back until every path
+ * reaches a definition.
+ */
+void RegisterAllocator::computeIntervals(const TACFunction& function)
+{
+    size_t blockCount = function.blocks.size();
+    uint32_t count = function.registerCount;
+    std::vector<uint32_t> blockStarts(blockCount), blockEnds(blockCount);
+    std::vector<std::vector<BlockId>> definingBlocks(count), usingBlocks(count);
+    std::vector<BlockId> definedIn(count, NoBlock), usedIn(count, NoBlock);
+
+    uint32_t position = 0;
+    for (BlockId id = 0; id < blockCount; id++)
+    {
+        blockStarts[id] = position;
+        for (const TACInstruction& instruction : function.blocks[id].instructions)
+        {
+            for (const TACOperand* operand : { &instruction.a, &instruction.b })
+            {
+                if (!operand->isRegister())
+                {
+                    continue;
+                }
+                VirtualRegister reg = operand->getRegister();
+                extend(reg, position);
+                if (definedIn[reg] != id && usedIn[reg] != id)
+                {
+                    usedIn[reg] = id;
+                    usingBlocks[reg].push_back(id);
+                }
+            }
+            if (instruction.result != NoRegister)
+            {
+                extend(instruction.result, position + 1);
+                if (definedIn[instruction.result] != id)
+                {
+                    definedIn[instruction.result] = id;
+                    definingBlocks[instruction.result].push_back(id);
+                }
+            }
+            if (instruction.op == CallOp)
+            {
+                callPositions.push_back(position);
+            }
+            position += 2;
+        }
+        blockEnds[id] = position - 1;
+    }
+
+    std::vector<VirtualRegister> liveIn(blockCount, NoRegister), defines(blockCount, NoRegister);
+    std::vector<BlockId> worklist;
+    for (VirtualRegister reg = 0; reg < count; reg++)
+    {
+        for (BlockId id : definingBlocks[reg])
+        {
+            defines[id] = reg;
+        }
+        worklist = usingBlocks[reg];
+        while (!worklist.empty())
+        {
+            BlockId id = worklist.back();
+            worklist.pop_back();
+            if (liveIn[id] == reg)
+            {
+                continue;
+            }
+            liveIn[id] = reg;
+            extend(reg, blockStarts[id]);
+            for (BlockId predecessor : function.blocks[id].predecessors)
+            {
+                extend(reg, blockEnds[predecessor]);
+                if (defines[predecessor] != reg && liveIn[predecessor] != reg)
+                {
+                    worklist.push_back(predecessor);
+                }
+            }
+        }
+    }
+}
+
+void RegisterAllocator::extend(VirtualRegister reg, uint32_t position)
+{
+    Interval& interval = intervals[reg];
+    interval.start = std::min(interval.start, position);
+    interval.end = std::max(interval.end, position);
+}
+
+/**
+ * Returns whether a call happens while the interval is live. A call's own
+ * result is written after the call, so it is not live across it.
+ */
+bool RegisterAllocator::isLiveAcrossCall(const Interval& interval) const
+{
+    auto call = std::lower_bound(callPositions.begin(), callPositions.end(), interval.start);
+    return call != callPositions.end() && *call < interval.end;
+}
+
+void RegisterAllocator::spill(VirtualRegister reg)
+{
+    assignments[reg] = Spilled;
+    spillSlots[reg] = spillSlotCount++;
+}
@@ -1,6 +1,6 @@
 #include "../include/ReturnNode.h"
 #include "../include/Visitor.h"
-ReturnNode::ReturnNode(ASTNode* toReturn)
+ReturnNode::ReturnNode(ASTNode* toReturn) : ASTNode(ReturnKind)
 {
     this->toReturn = toReturn;
 };
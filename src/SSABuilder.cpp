@@ -0,0 +1,173 @@
+#include "../include/SSABuilder.h"
+#include "../include/DominatorTree.h"
+
+void SSABuilder::build(TACFunction& function)
+{
+    static constexpr uint32_t NoSlot = UINT32_MAX;
+    DominatorTree tree(function);
+    size_t blockCount = function.blocks.size();
+    uint32_t slotCount = function.slotCount;
+
+    //A slot only needs phis if some block reads it before storing to it
+    std::vector<std::vector<BlockId>> storingBlocks(slotCount);
+    std::vector<BlockId> storedIn(slotCount, NoBlock);
+    std::vector<uint8_t> isLiveAcrossBlocks(slotCount, 0);
+    for (BlockId id : tree.getReversePostorder())
+    {
+        for (const TACInstruction& instruction : function.blocks[id].instructions)
+        {
+            uint32_t slot = (uint32_t)instruction.a.value;
+            if (instruction.op == LoadOp && storedIn[slot] != id)
+            {
+                isLiveAcrossBlocks[slot] = 1;
+            }
+            else if (instruction.op == StoreOp && storedIn[slot] != id)
+            {
+                storedIn[slot] = id;
+                storingBlocks[slot].push_back(id);
+            }
+        }
+    }
+
+    //Place a phi for the slot wherever stores to it, or phis for it, meet
+    std::vector<std::vector<BlockId>> frontiers = tree.getDominanceFrontiers(function);
+    std::vector<std::vector<uint32_t>> phiSlots(blockCount);
+    std::vector<uint32_t> hasPhi(blockCount, NoSlot), isQueued(blockCount, NoSlot);
+    std::vector<BlockId> worklist;
+    for (uint32_t slot = 0; slot < slotCount; slot++)
+    {
+        if (!isLiveAcrossBlocks[slot])
+        {
+            continue;
+        }
+        worklist = storingBlocks[slot];
+        for (BlockId id : worklist)
+        {
+            isQueued[id] = slot;
+        }
+        while (!worklist.empty())
+        {
+            BlockId id = worklist.back();
+            worklist.pop_back();
+            for (BlockId frontier : frontiers[id])
+            {
+                if (hasPhi[frontier] == slot)
+                {
+                    continue;
+                }
+                hasPhi[frontier] = slot;
+                BasicBlock& block = function.blocks[frontier];
+                block.phis.push_back({ function.newRegister(), std::vector<TACOperand>(block.predecessors.size(), TACOperand::makeImmediate(0)) });
+                phiSlots[frontier].push_back(slot);
+                if (isQueued[frontier] != slot)
+                {
+                    isQueued[frontier] = slot;
+                    worklist.push_back(frontier);
+                }
+            }
+        }
+    }
+
+    /**
+     * Walk down the dominator tree on an explicit stack. Each slot has a stack
+     * of the values stored to it on the way down, and a log of which slots
+     * were pushed lets each block undo its own pushes on the way back up.
+     */
+    struct Frame
+    {
+        BlockId block;
+        uint32_t nextChild;
+        size_t logSize;
+    };
+    std::vector<std::vector<TACOperand>> values(slotCount);
+    std::vector<uint32_t> pushedSlots;
+    std::vector<TACOperand> replacements(function.registerCount);
+    std::vector<std::vector<uint32_t>> predecessorIndices = function.getPredecessorIndices();
+    std::vector<Frame> stack;
+    auto getValue = [&](uint32_t slot)
+    {
+        return values[slot].empty() ? TACOperand::makeImmediate(0) : values[slot].back();
+    };
+    auto replaceOperands = [&](TACInstruction& instruction)
+    {
+        for (TACOperand* operand : { &instruction.a, &instruction.b })
+        {
+            if (operand->isRegister() && replacements[operand->getRegister()].kind != NoOperand)
+            {
+                *operand = replacements[operand->getRegister()];
+            }
+        }
+    };
+    auto enter = [&](BlockId id)
+    {
+        stack.push_back({ id, 0, pushedSlots.size() });
+        BasicBlock& block = function.blocks[id];
+        for (size_t i = 0; i < block.phis.size(); i++)
+        {
+            values[phiSlots[id][i]].push_back(TACOperand::makeRegister(block.phis[i].result));
+            pushedSlots.push_back(phiSlots[id][i]);
+        }
+
+        size_t kept = 0;
+        for (TACInstruction instruction : block.instructions)
+        {
+            replaceOperands(instruction);
+            uint32_t slot = (uint32_t)instruction.a.value;
+            if (instruction.op == LoadOp)
+            {
+                replacements[instruction.result] = getValue(slot);
+            }
+            else if (instruction.op == StoreOp)
+            {
+                values[slot].push_back(instruction.b);
+                pushedSlots.push_back(slot);
+            }
+            else
+            {
+                block.instructions[kept++] = instruction;
+            }
+        }
+        block.instructions.resize(kept);
+
+        //Fill in the phi operands for the edges leaving this block
+        for (size_t s = 0; s < block.successors.size(); s++)
+        {
+            BlockId successor = block.successors[s];
+            uint32_t k = predecessorIndices[id][s];
+            for (size_t i = 0; i < function.blocks[successor].phis.size(); i++)
+            {
+                function.blocks[successor].phis[i].incoming[k] = getValue(phiSlots[successor][i]);
+            }
+        }
+    };
+
+    enter(0);
+    while (!stack.empty())
+    {
+        Frame& frame = stack.back();
+        const std::vector<BlockId>& children = tree.getChildren(frame.block);
+        if (frame.nextChild < children.size())
+        {
+            enter(children[frame.nextChild++]);
+            continue;
+        }
+        for (size_t i = pushedSlots.size(); i > frame.logSize; i--)
+        {
+            values[pushedSlots[i - 1]].pop_back();
+        }
+        pushedSlots.resize(frame.logSize);
+        stack.pop_back();
+    }
+
+    //Unreachable blocks keep their loads and stores but must not refer to loads that are gone
+    for (BlockId id = 0; id < blockCount; id++)
+    {
+        if (!tree.isReachable(id))
+        {
+            for (TACInstruction& instruction : function.blocks[id].instructions)
+            {
+                replaceOperands(instruction);
+            }
+        }
+    }
+}
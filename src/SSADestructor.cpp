@@ -0,0 +1,96 @@
+#include "../include/SSADestructor.h"
+#include <algorithm>
+
+void SSADestructor::destruct(TACFunction& function)
+{
+    size_t blockCount = function.blocks.size();
+    std::vector<std::vector<BlockId>> edgeBlocks(blockCount);
+    std::vector<Copy> copies;
+    for (BlockId id = 0; id < blockCount; id++)
+    {
+        if (function.blocks[id].phis.empty())
+        {
+            continue;
+        }
+        for (size_t k = 0; k < function.blocks[id].predecessors.size(); k++)
+        {
+            copies.clear();
+            for (const TACPhi& phi : function.blocks[id].phis)
+            {
+                if (phi.incoming[k] != TACOperand::makeRegister(phi.result))
+                {
+                    copies.push_back({ phi.result, phi.incoming[k] });
+                }
+            }
+            if (copies.empty())
+            {
+                continue;
+            }
+
+            BlockId predecessor = function.blocks[id].predecessors[k], target = predecessor;
+            if (function.blocks[predecessor].successors.size() > 1)
+            {
+                target = function.newBlock();
+                std::vector<BlockId>& successors = function.blocks[predecessor].successors;
+                *std::find(successors.begin(), successors.end(), id) = target;
+                function.blocks[target].predecessors.push_back(predecessor);
+                function.blocks[target].successors.push_back(id);
+                function.blocks[target].instructions.push_back({ JumpOp, NoRegister, {}, {} });
+                function.blocks[id].predecessors[k] = target;
+                edgeBlocks[predecessor].push_back(target);
+            }
+            insertCopies(function, target, copies);
+        }
+        function.blocks[id].phis.clear();
+    }
+
+    //Lay each new edge block out right after the block it leaves
+    std::vector<BlockId> order;
+    for (BlockId id = 0; id < blockCount; id++)
+    {
+        order.push_back(id);
+        order.insert(order.end(), edgeBlocks[id].begin(), edgeBlocks[id].end());
+    }
+    function.reorderBlocks(order);
+}
+
+/**
+ * Inserts the copies before the block's terminator. They stand for the
+ * phis of one edge and so must act as if they all happened at once: a copy
+ * waits until no other copy still has to read its destination, and where
+ * the copies form a cycle, one destination is first saved to a new register.
+ */
+void SSADestructor::insertCopies(TACFunction& function, BlockId block, std::vector<Copy>& copies)
+{
+    std::vector<TACInstruction> sequence;
+    while (!copies.empty())
+    {
+        bool isEmitted = false;
+        for (size_t i = 0; i < copies.size() && !isEmitted; i++)
+        {
+            TACOperand destination = TACOperand::makeRegister(copies[i].first);
+            bool isRead = std::any_of(copies.begin(), copies.end(), [&](const Copy& copy) { return copy.second == destination; });
+            if (!isRead)
+            {
+                sequence.push_back({ MoveOp, copies[i].first, copies[i].second, {} });
+                copies.erase(copies.begin() + i);
+                isEmitted = true;
+            }
+        }
+        if (!isEmitted)
+        {
+            TACOperand destination = TACOperand::makeRegister(copies[0].first);
+            VirtualRegister saved = function.newRegister();
+            sequence.push_back({ MoveOp, saved, destination, {} });
+            for (Copy& copy : copies)
+            {
+                if (copy.second == destination)
+                {
+                    copy.second = TACOperand::makeRegister(saved);
+                }
+            }
+        }
+    }
+    std::vector<TACInstruction>& instructions = function.blocks[block].instructions;
+    instructions.insert(instructions.end() - 1, sequence.begin(), sequence.end());
+}
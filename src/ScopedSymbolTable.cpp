@@ -0,0 +1,56 @@
+#include "../include/ScopedSymbolTable.h"
+
+void ScopedSymbolTable::pushScope()
+{
+    scopeStarts.push_back((uint32_t)bindings.size());
+}
+
+/**
+ * Removes every binding declared in the innermost scope, making the bindings
+ * they shadowed visible again
+ */
+void ScopedSymbolTable::popScope()
+{
+    uint32_t start = scopeStarts.back();
+    scopeStarts.pop_back();
+    while (bindings.size() > start)
+    {
+        const Binding& binding = bindings.back();
+        visible[binding.symbol] = binding.shadowed;
+        bindings.pop_back();
+    }
+}
+
+/**
+ * Binds a symbol in the innermost scope, shadowing any outer binding
+ */
+void ScopedSymbolTable::declare(Symbol symbol, ASTNode* node)
+{
+    if (symbol >= visible.size())
+    {
+        visible.resize(symbol + 1, NoBinding);
+    }
+    bindings.push_back({ symbol, (uint32_t)scopeStarts.size(), visible[symbol], node });
+    visible[symbol] = (uint32_t)bindings.size() - 1;
+}
+
+/**
+ * Returns the node of the innermost visible binding, or null if there is none
+ */
+ASTNode* ScopedSymbolTable::lookup(Symbol symbol) const
+{
+    if (symbol >= visible.size() || visible[symbol] == NoBinding)
+    {
+        return nullptr;
+    }
+    return bindings[visible[symbol]].node;
+}
+
+bool ScopedSymbolTable::isDeclaredInCurrentScope(Symbol symbol) const
+{
+    if (symbol >= visible.size() || visible[symbol] == NoBinding)
+    {
+        return false;
+    }
+    return bindings[visible[symbol]].depth == scopeStarts.size();
+}
@@ -0,0 +1,140 @@
+#include "../include/SourceFile.h"
+#include <fstream>
+#include <sstream>
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+/**
+ * Constructor. Maps the file into memory, falling back to reading it into an
+ * owned buffer when the file cannot be mapped (e.g. it is empty). A file that
+ * cannot be opened reads as empty and isOpen returns false.
+ */
+SourceFile::SourceFile(const std::string& path)
+{
+    if (map(path))
+    {
+        return;
+    }
+
+    std::ifstream file{ path, std::ios::binary };
+    if (!file)
+    {
+        isOpened = false;
+        return;
+    }
+    std::stringstream stream;
+    stream << file.rdbuf();
+    this->buffer = stream.str();
+    this->data = buffer.data();
+    this->size = buffer.size();
+}
+
+SourceFile::~SourceFile()
+{
+    unmap();
+}
+
+/**
+ * Returns a view of the entire file contents
+ */
+std::string_view SourceFile::getText() const
+{
+    return std::string_view(data, size);
+}
+
+bool SourceFile::isOpen() const
+{
+    return isOpened;
+}
+
+#ifdef _WIN32
+bool SourceFile::map(const std::string& path)
+{
+    HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+    if (file == INVALID_HANDLE_VALUE)
+    {
+        return false;
+    }
+    LARGE_INTEGER fileSize;
+    if (!GetFileSizeEx(file, &fileSize) || fileSize.QuadPart == 0)
+    {
+        CloseHandle(file);
+        return false;
+    }
+    HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (!mapping)
+    {
+        CloseHandle(file);
+        return false;
+    }
+    void* view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    if (!view)
+    {
+        CloseHandle(mapping);
+        CloseHandle(file);
+        return false;
+    }
+    this->fileHandle = file;
+    this->mappingHandle = mapping;
+    this->data = static_cast<const char*>(view);
+    this->size = static_cast<size_t>(fileSize.QuadPart);
+    this->isMapped = true;
+    return true;
+}
+
+void SourceFile::unmap()
+{
+    if (!isMapped)
+    {
+        return;
+    }
+    UnmapViewOfFile(data);
+    CloseHandle(mappingHandle);
+    CloseHandle(fileHandle);
+    isMapped = false;
+}
+#else
+bool SourceFile::map(const std::string& path)
+{
+    int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0)
+    {
+        return false;
+    }
+    struct stat info;
+    if (fstat(fd, &info) != 0 || info.st_size == 0)
+    {
+        close(fd);
+        return false;
+    }
+    void* view = mmap(nullptr, info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    //The mapping keeps its own reference to the file, so the descriptor can go
+    close(fd);
+    if (view == MAP_FAILED)
+    {
+        return false;
+    }
+    madvise(view, info.st_size, MADV_SEQUENTIAL);
+    this->data = static_cast<const char*>(view);
+    this->size = static_cast<size_t>(info.st_size);
+    this->isMapped = true;
+    return true;
+}
+
+void SourceFile::unmap()
+{
+    if (!isMapped)
+    {
+        return;
+    }
+    munmap(const_cast<char*>(data), size);
+    isMapped = false;
+}
+#endif
@@ -1,8 +1,9 @@
 #include "../include/StringLiteralNode.h"
 #include "../include/Visitor.h"
-StringLiteralNode::StringLiteralNode(std::string value)
+StringLiteralNode::StringLiteralNode(std::string value, uint32_t poolIndex) : ASTNode(StringLiteralKind)
 {
     this->value = value;
+    this->poolIndex = poolIndex;
 };
 
 void StringLiteralNode::accept(Visitor& v)
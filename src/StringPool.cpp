@@ -0,0 +1,29 @@
+#include "../include/StringPool.h"
+
+/**
+ * Adds a literal if it is not already pooled and returns its index
+ */
+uint32_t StringPool::add(std::string_view text)
+{
+    auto entry = indices.try_emplace(std::string(text), (uint32_t)strings.size());
+    if (entry.second)
+    {
+        strings.push_back(&entry.first->first);
+    }
+    return entry.first->second;
+}
+
+uint32_t StringPool::size() const
+{
+    return (uint32_t)strings.size();
+}
+
+const std::string& StringPool::getText(uint32_t index) const
+{
+    return *strings[index];
+}
+
+std::string StringPool::getLabel(uint32_t index)
+{
+    return ".LC" + std::to_string(index);
+}
@@ -1,17 +1,35 @@
 #include "../include/SyntaxToken.h"
-#include <string>
 
-SyntaxToken::SyntaxToken(SyntaxType syntaxType, std::string text)
+SyntaxToken::SyntaxToken(SyntaxType syntaxType, uint32_t value)
 {
     this->syntaxType = syntaxType;
-    this->text = text;
+    this->value = value;
 }
 
 SyntaxToken::SyntaxToken() {}
 
-std::string SyntaxToken::getText()
+/**
+ * Returns the source offset of a non-identifier token
+ */
+uint32_t SyntaxToken::getOffset()
 {
-    return this->text;
+    return this->value;
+}
+
+/**
+ * Returns the interned symbol of an identifier token
+ */
+Symbol SyntaxToken::getSymbol()
+{
+    return this->value;
+}
+
+/**
+ * Returns the raw value, whichever of the two it holds
+ */
+uint32_t SyntaxToken::getValue()
+{
+    return this->value;
 }
 
 SyntaxType SyntaxToken::getSyntaxType()
@@ -0,0 +1,118 @@
+#include "../include/ThreadPool.h"
+#include <algorithm>
+
+/**
+ * Constructor. The calling thread always takes part in its own loops, so a
+ * pool of zero workers runs everything on the caller.
+ */
+ThreadPool::ThreadPool(unsigned threadCount)
+{
+    for (unsigned i = 0; i < threadCount; i++)
+    {
+        workers.emplace_back(&ThreadPool::runWorker, this);
+    }
+}
+
+ThreadPool::~ThreadPool()
+{
+    {
+        std::lock_guard<std::mutex> lock{ mutex };
+        isStopping = true;
+    }
+    hasWork.notify_all();
+    for (auto& worker : workers)
+    {
+        worker.join();
+    }
+}
+
+/**
+ * Returns one worker per hardware thread besides the caller
+ */
+unsigned ThreadPool::getDefaultThreadCount()
+{
+    unsigned hardwareThreads = std::thread::hardware_concurrency();
+    return hardwareThreads > 1 ? hardwareThreads - 1 : 0;
+}
+
+/**
+ * Calls task(i) for every i below count and returns once all calls are done
+ */
+void ThreadPool::parallelFor(size_t count, const std::function<void(size_t)>& task)
+{
+    if (count == 0)
+    {
+        return;
+    }
+    auto job = std::make_shared<Job>();
+    job->task = &task;
+    job->count = count;
+    if (!workers.empty() && count > 1)
+    {
+        {
+            std::lock_guard<std::mutex> lock{ mutex };
+            jobs.push_back(job);
+        }
+        hasWork.notify_all();
+    }
+
+    runIterations(job);
+
+    std::unique_lock<std::mutex> lock{ mutex };
+    hasFinished.wait(lock, [&] { return job->done == job->count; });
+}
+
+/**
+ * Claims and runs iterations of a job until none are left unclaimed
+ */
+void ThreadPool::runIterations(const std::shared_ptr<Job>& job)
+{
+    while (true)
+    {
+        size_t index = job->next++;
+        if (index >= job->count)
+        {
+            removeJob(job);
+            return;
+        }
+        (*job->task)(index);
+        if (++job->done == job->count)
+        {
+            //Taking the lock orders this notification after the caller's check
+            std::lock_guard<std::mutex> lock{ mutex };
+            hasFinished.notify_all();
+        }
+    }
+}
+
+void ThreadPool::removeJob(const std::shared_ptr<Job>& job)
+{
+    std::lock_guard<std::mutex> lock{ mutex };
+    auto entry = std::find(jobs.begin(), jobs.end(), job);
+    if (entry != jobs.end())
+    {
+        jobs.erase(entry);
+    }
+}
+
+/**
+ * Body of each worker thread: help with the oldest job that still has
+ * unclaimed iterations
+ */
+void ThreadPool::runWorker()
+{
+    while (true)
+    {
+        std::shared_ptr<Job> job;
+        {
+            std::unique_lock<std::mutex> lock{ mutex };
+            hasWork.wait(lock, [&] { return isStopping || !jobs.empty(); });
+            if (isStopping)
+            {
+                return;
+            }
+            job = jobs.front();
+        }
+        runIterations(job);
+    }
+}
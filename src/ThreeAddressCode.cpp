@@ -0,0 +1,173 @@
+#include "../include/ThreeAddressCode.h"
+#include "../include/OutputSink.h"
+
+BlockId TACFunction::newBlock()
+{
+    blocks.emplace_back();
+    return (BlockId)(blocks.size() - 1);
+}
+
+void TACFunction::addEdge(BlockId from, BlockId to)
+{
+    blocks[from].successors.push_back(to);
+    blocks[to].predecessors.push_back(from);
+}
+
+/**
+ * Returns, for each block and each of its successors, where the block is
+ * listed in that successor's predecessors, which is also the index of the
+ * edge's operand in the successor's phis. Passes use it to go from an edge
+ * to its phi operands without searching a join's predecessors, which would
+ * make wide joins quadratic.
+ */
+std::vector<std::vector<uint32_t>> TACFunction::getPredecessorIndices() const
+{
+    std::vector<std::vector<uint32_t>> indices(blocks.size());
+    for (BlockId id = 0; id < blocks.size(); id++)
+    {
+        indices[id].assign(blocks[id].successors.size(), UINT32_MAX);
+    }
+    for (BlockId id = 0; id < blocks.size(); id++)
+    {
+        const std::vector<BlockId>& predecessors = blocks[id].predecessors;
+        for (uint32_t k = 0; k < predecessors.size(); k++)
+        {
+            //A block has at most two successors, and an edge may be listed twice
+            const std::vector<BlockId>& successors = blocks[predecessors[k]].successors;
+            for (size_t i = 0; i < successors.size(); i++)
+            {
+                if (successors[i] == id && indices[predecessors[k]][i] == UINT32_MAX)
+                {
+                    indices[predecessors[k]][i] = k;
+                    break;
+                }
+            }
+        }
+    }
+    return indices;
+}
+
+/**
+ * Lays the blocks out in the given order, which must start with the entry,
+ * and renumbers them to match. Blocks left out of the order are dropped
+ * along with their edges.
+ */
+void TACFunction::reorderBlocks(const std::vector<BlockId>& order)
+{
+    std::vector<BlockId> newIds(blocks.size(), NoBlock);
+    for (BlockId i = 0; i < order.size(); i++)
+    {
+        newIds[order[i]] = i;
+    }
+
+    std::vector<BasicBlock> reordered;
+    reordered.reserve(order.size());
+    for (BlockId id : order)
+    {
+        BasicBlock& block = reordered.emplace_back(std::move(blocks[id]));
+        for (BlockId& successor : block.successors)
+        {
+            successor = newIds[successor];
+        }
+        size_t kept = 0;
+        for (BlockId predecessor : block.predecessors)
+        {
+            if (newIds[predecessor] != NoBlock)
+            {
+                block.predecessors[kept++] = newIds[predecessor];
+            }
+        }
+        block.predecessors.resize(kept);
+    }
+    blocks = std::move(reordered);
+}
+
+static void printOperand(OutputSink& out, const TACOperand& operand)
+{
+    switch (operand.kind)
+    {
+        case RegisterOperand:
+            out << "t" << operand.value;
+            break;
+        case ImmediateOperand:
+            out << operand.value;
+            break;
+        case StringOperand:
+            out << "str" << operand.value;
+            break;
+        default:
+            out << "_";
+            break;
+    }
+}
+
+/**
+ * Writes the function in a readable form, for debugging
+ */
+void TACFunction::print(OutputSink& out) const
+{
+    static const char* const names[] = {
+        "move", "add", "sub", "mul", "div", "lt", "le", "gt", "ge", "eq",
+        "param", "load", "store", "arg", "call", "jump", "branch", "return"
+    };
+
+    out << name << ":\n";
+    for (BlockId id = 0; id < blocks.size(); id++)
+    {
+        const BasicBlock& block = blocks[id];
+        out << "B" << id << ":";
+        if (!block.predecessors.empty())
+        {
+            out << "\t\t# from";
+            for (BlockId predecessor : block.predecessors)
+            {
+                out << " B" << predecessor;
+            }
+        }
+        out << "\n";
+        for (const TACPhi& phi : block.phis)
+        {
+            out << "\tt" << phi.result << " = phi";
+            for (size_t i = 0; i < phi.incoming.size(); i++)
+            {
+                out << (i ? ", " : " ");
+                printOperand(out, phi.incoming[i]);
+            }
+            out << "\n";
+        }
+        for (const TACInstruction& instruction : block.instructions)
+        {
+            out << "\t";
+            if (instruction.result != NoRegister)
+            {
+                out << "t" << instruction.result << " = ";
+            }
+            out << names[instruction.op];
+            if (instruction.op == CallOp)
+            {
+                out << " " << callees[instruction.a.value] << "/" << instruction.b.value;
+            }
+            else
+            {
+                if (instruction.a.kind != NoOperand)
+                {
+                    out << " ";
+                    printOperand(out, instruction.a);
+                }
+                if (instruction.b.kind != NoOperand)
+                {
+                    out << ", ";
+                    printOperand(out, instruction.b);
+                }
+            }
+            if (instruction.isTerminator())
+            {
+                for (BlockId successor : block.successors)
+                {
+                    out << " B" << successor;
+                }
+            }
+            out << "\n";
+        }
+    }
+}
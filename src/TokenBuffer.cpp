@@ -0,0 +1,108 @@
+#include "../include/TokenBuffer.h"
+#include <iostream>
+
+/**
+ * Constructor. When pipelined, starts the lexer thread immediately.
+ */
+TokenBuffer::TokenBuffer(Lexer& lexer, bool isPipelined) : lexer{ lexer }
+{
+    if (isPipelined)
+    {
+        queue = std::make_unique<TokenQueue>();
+        lexerThread = std::thread(&TokenBuffer::runLexer, this);
+    }
+}
+
+TokenBuffer::~TokenBuffer()
+{
+    if (lexerThread.joinable())
+    {
+        isStopping = true;
+        lexerThread.join();
+    }
+}
+
+/**
+ * Body of the lexer thread: lex until EOF or an error, waiting whenever the
+ * queue is full. Errors travel through the queue as tokens so that they are
+ * reported on the parser's thread.
+ */
+void TokenBuffer::runLexer()
+{
+    while (true)
+    {
+        auto token = lexer.lex();
+        while (!queue->tryPush(token))
+        {
+            if (isStopping)
+            {
+                return;
+            }
+            std::this_thread::yield();
+        }
+        if (token.getSyntaxType() == EOFToken || token.getSyntaxType() == ErrorToken)
+        {
+            return;
+        }
+    }
+}
+
+/**
+ * Produces the next token, either from the lexer or from the lexer thread
+ */
+SyntaxToken TokenBuffer::pull()
+{
+    if (!queue)
+    {
+        //Once the input is exhausted the lexer keeps producing EOF tokens
+        return lexer.lex();
+    }
+    if (hasReceivedLastToken)
+    {
+        return lastToken;
+    }
+    SyntaxToken token;
+    while (!queue->tryPop(token))
+    {
+        std::this_thread::yield();
+    }
+    if (token.getSyntaxType() == EOFToken || token.getSyntaxType() == ErrorToken)
+    {
+        hasReceivedLastToken = true;
+        lastToken = token;
+    }
+    return token;
+}
+
+/**
+ * Returns the token at the given offset from the current one, lexing more
+ * of the input if the window does not hold it yet
+ */
+SyntaxToken TokenBuffer::peek(int offset)
+{
+    if (offset >= Capacity)
+    {
+        std::cerr << "Error: Lookahead of " << offset << " exceeds the token window.\n";
+        exit(EXIT_FAILURE);
+    }
+    while (count <= (unsigned)offset)
+    {
+        auto token = pull();
+        unsigned tail = (head + count) & (Capacity - 1);
+        types[tail] = token.getSyntaxType();
+        values[tail] = token.getValue();
+        count++;
+    }
+    unsigned index = (head + offset) & (Capacity - 1);
+    return SyntaxToken(types[index], values[index]);
+}
+
+/**
+ * Discards the current token
+ */
+void TokenBuffer::advance()
+{
+    peek(0);
+    head = (head + 1) & (Capacity - 1);
+    count--;
+}
@@ -0,0 +1,42 @@
+#include "../include/TokenQueue.h"
+
+/**
+ * Appends a token. Returns false if the ring is full. Producer only.
+ */
+bool TokenQueue::tryPush(SyntaxToken token)
+{
+    unsigned currentTail = tail.load(std::memory_order_relaxed);
+    if (currentTail - cachedHead == Capacity)
+    {
+        cachedHead = head.load(std::memory_order_acquire);
+        if (currentTail - cachedHead == Capacity)
+        {
+            return false;
+        }
+    }
+    unsigned index = currentTail & (Capacity - 1);
+    types[index] = token.getSyntaxType();
+    values[index] = token.getValue();
+    tail.store(currentTail + 1, std::memory_order_release);
+    return true;
+}
+
+/**
+ * Removes the oldest token. Returns false if the ring is empty. Consumer only.
+ */
+bool TokenQueue::tryPop(SyntaxToken& token)
+{
+    unsigned currentHead = head.load(std::memory_order_relaxed);
+    if (currentHead == cachedTail)
+    {
+        cachedTail = tail.load(std::memory_order_acquire);
+        if (currentHead == cachedTail)
+        {
+            return false;
+        }
+    }
+    unsigned index = currentHead & (Capacity - 1);
+    token = SyntaxToken(types[index], values[index]);
+    head.store(currentHead + 1, std::memory_order_release);
+    return true;
+}
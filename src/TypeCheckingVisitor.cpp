@@ -5,24 +5,124 @@
 #include "../include/TypeCheckingVisitor.h"
 #include "../include/VariableDeclarationNode.h"
 #include "../include/BooleanLiteralNode.h"
-#include "../include/Visitor.h"
 #include "../include/VariableNode.h"
 #include "../include/FunctionDeclarationNode.h"
 #include "../include/ReturnNode.h"
 #include "../include/ProgramNode.h"
 #include "../include/Type.h"
-#include <iostream>
+#include "../include/FunctionCallNode.h"
+#include "../include/WhileNode.h"
+
+/**
+ * Constructor. If a pool is given, the functions of a program are checked on
+ * it in parallel.
+ */
+TypeCheckingVisitor::TypeCheckingVisitor(ThreadPool* pool) : pool{ pool } {}
+
+/**
+ * Constructor for checking a single function against the program's signatures
+ */
+TypeCheckingVisitor::TypeCheckingVisitor(const std::unordered_map<Symbol, Type>* signatures) : signatures{ signatures } {}
+
+/**
+ * Checks the tree rooted at the given node and returns true if it is well typed
+ */
+bool TypeCheckingVisitor::check(ASTNode* root)
+{
+    if (root->getKind() == ProgramKind)
+    {
+        checkProgram(static_cast<ProgramNode*>(root));
+    }
+    else
+    {
+        walk(root);
+        types.clear();
+    }
+    return errors.empty();
+}
+
+const std::vector<std::string>& TypeCheckingVisitor::getErrors()
+{
+    return this->errors;
+}
+
+void TypeCheckingVisitor::checkProgram(ProgramNode* node)
+{
+    //Calls may refer to functions declared later, so collect every signature first
+    std::unordered_map<Symbol, Type> programSignatures;
+    auto units = node->getProgramUnits();
+    for (auto unit : units)
+    {
+        auto function = static_cast<FunctionDeclarationNode*>(unit);
+        programSignatures[function->functionSymbol] = function->getReturnType();
+    }
+
+    //Each function gets its own checker, and its errors are kept apart until all are done
+    std::vector<std::vector<std::string>> functionErrors(units.size());
+    auto checkFunction = [&](size_t i)
+    {
+        TypeCheckingVisitor checker(&programSignatures);
+        checker.walk(units[i]);
+        functionErrors[i] = std::move(checker.errors);
+    };
+    if (pool)
+    {
+        pool->parallelFor(units.size(), checkFunction);
+    }
+    else
+    {
+        for (size_t i = 0; i < units.size(); i++)
+        {
+            checkFunction(i);
+        }
+    }
+    for (auto& messages : functionErrors)
+    {
+        errors.insert(errors.end(), messages.begin(), messages.end());
+    }
+}
+
+void TypeCheckingVisitor::reportError(const std::string& message)
+{
+    errors.push_back("Error in function \"" + std::string(functionName) + "\": " + message);
+}
+
+void TypeCheckingVisitor::enterNode(ASTNode* node)
+{
+    //Return statements are checked against the function they appear in
+    if (node->getKind() == FunctionDeclarationKind)
+    {
+        auto function = static_cast<FunctionDeclarationNode*>(node);
+        functionType = function->getReturnType();
+        functionName = function->getFunctionName();
+    }
+}
+
+/**
+ * Checks a node once its children are done and leaves the node's type on the
+ * stack for its parent
+ */
+void TypeCheckingVisitor::leaveNode(ASTNode* node)
+{
+    visit(node);
+    types.push_back(this->type);
+}
+
+Type TypeCheckingVisitor::popType()
+{
+    Type top = types.back();
+    types.pop_back();
+    return top;
+}
 
 void TypeCheckingVisitor::visitBinaryOperatorNode(BinaryOperatorNode* node)
 {
     Type t1, t2;
-    if (node->left) {
-        node->left->accept(*this);
-        t1 = this->getType();
-    }
     if (node->right) {
-        node->right->accept(*this);
-        t2 = this->getType();
+        t2 = popType();
+    }
+    if (node->left) {
+        t1 = popType();
     }
 
     switch (node->op)
@@ -33,8 +133,7 @@ void TypeCheckingVisitor::visitBinaryOperatorNode(BinaryOperatorNode* node)
         case MultiplicationOperator:
             if (t1 == BooleanPrimitive || t2 == BooleanPrimitive)
             {
-                std::cout << "Invalid operand types";
-                exit(EXIT_FAILURE);
+                reportError("Invalid operand types");
             }
             if (t1 == IntegerPrimitive)
             {
@@ -45,11 +144,13 @@ void TypeCheckingVisitor::visitBinaryOperatorNode(BinaryOperatorNode* node)
             }
             break;
         case GreaterThanOperator:
+        case GreaterThanOrEqualToOperator:
         case LessThanOperator:
+        case LessThanOrEqualToOperator:
+        case EqualsOperator:
             if (t1 == BooleanPrimitive || t2 == BooleanPrimitive)
             {
-                std::cout << "Invalid operand types";
-                exit(EXIT_FAILURE);
+                reportError("Invalid operand types");
             }
             this->setType(BooleanPrimitive);
             break;
@@ -57,11 +158,17 @@ void TypeCheckingVisitor::visitBinaryOperatorNode(BinaryOperatorNode* node)
         case LogicalOrOperator:
             if (t1 != BooleanPrimitive || t2 != BooleanPrimitive)
             {
-                std::cout << "Invalid operand types";
-                exit(EXIT_FAILURE);
+                reportError("Invalid operand types");
             }
             this->setType(BooleanPrimitive);
             break;
+        case AssignmentOperator:
+            //The parser puts the assigned value on the left and the target on the right
+            if (node->right->getKind() != VariableKind)
+            {
+                reportError("Cannot assign to an expression that is not a variable");
+            }
+            break;
     }
     return;
 
@@ -75,18 +182,15 @@ void TypeCheckingVisitor::visitIntegerLiteralNode(IntegerLiteralNode* node)
 
 void TypeCheckingVisitor::visitCompoundStatementNode(CompoundStatementNode* node)
 {
-    for (auto statement : node->getStatements())
-    {
-        statement->accept(*this);
-    }
+    types.resize(types.size() - node->getStatements().size());
     return;
 }
 
 void TypeCheckingVisitor::visitIfStatementNode(IfStatementNode* node)
 {
-    node->getCondition()->accept(*this);
-    node->getIfStmtBody()->accept(*this);
-    if (node->getElseBody()) { node->getElseBody()->accept(*this); }
+    if (node->getElseBody()) { popType(); }
+    popType();
+    popType();
     return;
 }
 
@@ -107,38 +211,31 @@ Type TypeCheckingVisitor::getType()
 
 void TypeCheckingVisitor::visitVariableNode(VariableNode* node)
 {
-    if (isTypeInference)
-    {
-        node->setType(type);
-    }
-    else
-    {
-        this->setType(node->getType());
-    }
+    this->setType(node->getType());
     return;
 }
 
 void TypeCheckingVisitor::visitVariableDeclarationNode(VariableDeclarationNode* node)
 {
+    //Parameters are declared without an initializer
+    if (!node->getRHS())
+    {
+        this->setType(popType());
+        return;
+    }
     Type t1, t2;
-    node->getVarNode()->accept(*this);
-    t1 = this->getType();
-    node->getRHS()->accept(*this);
-    t2 = this->getType();
+    t2 = popType();
+    t1 = popType();
     if (t1 == ImplicitVarType)
     {
-        isTypeInference = true;
-        type = t2;
-        node->getVarNode()->accept(*this);
+        static_cast<VariableNode*>(node->getVarNode())->setType(t2);
         this->setType(t2);
-        isTypeInference = false;
     }
     else if (t1 == IntegerPrimitive)
     {
         if (t2 == BooleanPrimitive)
         {
-            std::cerr << "Cannot initialize type int with type boolean";
-            exit(EXIT_FAILURE);
+            reportError("Cannot initialize type int with type boolean");
         }
         this->setType(t1);
     }
@@ -146,8 +243,7 @@ void TypeCheckingVisitor::visitVariableDeclarationNode(VariableDeclarationNode*
     {
         if (t2 == IntegerPrimitive)
         {
-            std::cerr << "Cannot initialize type bool with type int";
-            exit(EXIT_FAILURE);
+            reportError("Cannot initialize type bool with type int");
         }
         this->setType(BooleanPrimitive);
     }
@@ -161,36 +257,45 @@ void TypeCheckingVisitor::visitBooleanLiteralNode(BooleanLiteralNode* node)
 
 void TypeCheckingVisitor::visitReturnNode(ReturnNode* node)
 {
-    node->toReturn->accept(*this);
-    Type returnType = this->getType();
+    Type returnType = popType();
     if (returnType != functionType)
     {
-        std::cerr << "Function must return specified type\n";
+        reportError("Function must return specified type");
     }
     return;
 }
 
 void TypeCheckingVisitor::visitFunctionDeclarationNode(FunctionDeclarationNode* node)
 {
-    functionType = node->getReturnType();
-    node->getFunctionBody()->accept(*this);
+    types.resize(types.size() - node->getParameterList().size() - 1);
     return;
 }
 
 void TypeCheckingVisitor::visitFunctionCallNode(FunctionCallNode* node)
 {
+    types.resize(types.size() - node->getArguments().size());
 
+    //Functions outside the program, such as printf, return int
+    Type returnType = IntegerPrimitive;
+    if (signatures)
+    {
+        auto entry = signatures->find(node->getSymbol());
+        if (entry != signatures->end())
+        {
+            returnType = entry->second;
+        }
+    }
+    this->setType(returnType);
 }
 
 void TypeCheckingVisitor::visitProgramNode(ProgramNode* node)
 {
-    for (auto& programUnit : node->getProgramUnits())
-    {
-        programUnit->accept(*this);
-    }
+    types.resize(types.size() - node->getProgramUnits().size());
 }
 
 void TypeCheckingVisitor::visitWhileNode(WhileNode* node)
 {
+    popType();
+    popType();
 
 }
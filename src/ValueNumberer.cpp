@@ -0,0 +1,162 @@
+#include "../include/ValueNumberer.h"
+#include "../include/DominatorTree.h"
+#include <algorithm>
+#include <functional>
+#include <utility>
+
+void ValueNumberer::number(TACFunction& function)
+{
+    DominatorTree tree(function);
+    replacements.assign(function.registerCount, {});
+    predecessorIndices = function.getPredecessorIndices();
+    available.clear();
+    addedExpressions.clear();
+
+    //Walk down the dominator tree on an explicit stack, taking each block's expressions out of the table on the way back up
+    struct Frame
+    {
+        BlockId block;
+        uint32_t nextChild;
+        size_t logSize;
+    };
+    std::vector<Frame> stack;
+    auto enter = [&](BlockId id)
+    {
+        stack.push_back({ id, 0, addedExpressions.size() });
+        numberBlock(function, id);
+    };
+
+    enter(0);
+    while (!stack.empty())
+    {
+        Frame& frame = stack.back();
+        const std::vector<BlockId>& children = tree.getChildren(frame.block);
+        if (frame.nextChild < children.size())
+        {
+            enter(children[frame.nextChild++]);
+            continue;
+        }
+        for (size_t i = addedExpressions.size(); i > frame.logSize; i--)
+        {
+            available.erase(addedExpressions[i - 1]);
+        }
+        addedExpressions.resize(frame.logSize);
+        stack.pop_back();
+    }
+}
+
+/**
+ * Returns the value that stands for the operand. A phi can be replaced by an
+ * operand that comes around a back edge and is itself replaced later, so
+ * replacements are followed until one is kept.
+ */
+TACOperand ValueNumberer::getReplacement(const TACOperand& operand) const
+{
+    TACOperand value = operand;
+    while (value.isRegister() && replacements[value.getRegister()].kind != NoOperand)
+    {
+        value = replacements[value.getRegister()];
+    }
+    return value;
+}
+
+void ValueNumberer::numberBlock(TACFunction& function, BlockId id)
+{
+    BasicBlock& block = function.blocks[id];
+
+    //A phi whose operands, apart from itself, are all one value is that value
+    size_t kept = 0;
+    for (size_t i = 0; i < block.phis.size(); i++)
+    {
+        TACPhi& phi = block.phis[i];
+        TACOperand self = TACOperand::makeRegister(phi.result), value;
+        bool isSameValue = true;
+        for (TACOperand& operand : phi.incoming)
+        {
+            operand = getReplacement(operand);
+            if (operand == self)
+            {
+                continue;
+            }
+            if (value.kind == NoOperand)
+            {
+                value = operand;
+            }
+            else if (operand != value)
+            {
+                isSameValue = false;
+            }
+        }
+        if (isSameValue && value.kind != NoOperand)
+        {
+            replacements[phi.result] = value;
+            eliminatedCount++;
+        }
+        else if (kept++ != i)
+        {
+            block.phis[kept - 1] = std::move(phi);
+        }
+    }
+    block.phis.resize(kept);
+
+    kept = 0;
+    for (TACInstruction instruction : block.instructions)
+    {
+        instruction.a = getReplacement(instruction.a);
+        instruction.b = getReplacement(instruction.b);
+        if (instruction.op == MoveOp)
+        {
+            replacements[instruction.result] = instruction.a;
+            eliminatedCount++;
+            continue;
+        }
+        if (isPure(instruction.op))
+        {
+            Expression expression{ instruction.op, instruction.a, instruction.b };
+            if (isCommutative(expression.op) && std::make_pair(expression.b.kind, expression.b.value) < std::make_pair(expression.a.kind, expression.a.value))
+            {
+                std::swap(expression.a, expression.b);
+            }
+            auto entry = available.try_emplace(expression, instruction.result);
+            if (!entry.second)
+            {
+                replacements[instruction.result] = TACOperand::makeRegister(entry.first->second);
+                eliminatedCount++;
+                continue;
+            }
+            addedExpressions.push_back(expression);
+        }
+        block.instructions[kept++] = instruction;
+    }
+    block.instructions.resize(kept);
+
+    //Phi operands for the edges leaving this block are defined in blocks that dominate it, so these are final by now
+    for (size_t s = 0; s < block.successors.size(); s++)
+    {
+        uint32_t k = predecessorIndices[id][s];
+        for (TACPhi& phi : function.blocks[block.successors[s]].phis)
+        {
+            phi.incoming[k] = getReplacement(phi.incoming[k]);
+        }
+    }
+}
+
+/**
+ * Returns whether the operation's result depends only on its operands. A
+ * division that traps does so the first time, so a repeat of it can go too.
+ */
+bool ValueNumberer::isPure(TACOpcode op)
+{
+    return op >= AddOp && op <= EqualsOp;
+}
+
+bool ValueNumberer::isCommutative(TACOpcode op)
+{
+    return op == AddOp || op == MultiplyOp || op == EqualsOp;
+}
+
+size_t ValueNumberer::ExpressionHash::operator()(const Expression& expression) const
+{
+    size_t hash = std::hash<int64_t>()(expression.a.value) * 31 + std::hash<int64_t>()(expression.b.value);
+    return (hash * 31 + expression.op) * 31 + expression.a.kind * 4 + expression.b.kind;
+}
@@ -1,10 +1,11 @@
 #include "../include/VariableDeclarationNode.h"
 #include "../include/Visitor.h"
 
-VariableDeclarationNode::VariableDeclarationNode(ASTNode* varNode, ASTNode* rhs, std::string identifier)
+VariableDeclarationNode::VariableDeclarationNode(ASTNode* varNode, ASTNode* rhs, Symbol symbol, std::string_view identifier) : ASTNode(VariableDeclarationKind)
 {
     this->varNode = varNode;
     this->rhs = rhs;
+    this->symbol = symbol;
     this->identifier = identifier;
 }
 
@@ -23,12 +24,22 @@ Type VariableDeclarationNode::getType()
     return this->type;
 }
 
-std::string VariableDeclarationNode::getIdentifier()
+std::string_view VariableDeclarationNode::getIdentifier()
 {
     return this->identifier;
 }
 
+Symbol VariableDeclarationNode::getSymbol()
+{
+    return this->symbol;
+}
+
 ASTNode* VariableDeclarationNode::getVarNode()
 {
     return this->varNode;
-}
\ No newline at end of file
+}
+
+int VariableDeclarationNode::getSlot()
+{
+    return static_cast<VariableNode*>(this->varNode)->getSlot();
+}
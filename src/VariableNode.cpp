@@ -1,8 +1,9 @@
 #include "../include/VariableNode.h"
 #include "../include/Visitor.h"
-VariableNode::VariableNode(Type type, std::string identifier, bool isLocal)
+VariableNode::VariableNode(Type type, Symbol symbol, std::string_view identifier, bool isLocal) : ASTNode(VariableKind)
 {
     this->type = type;
+    this->symbol = symbol;
     this->identifier = identifier;
     this->isLocal = isLocal;
 };
@@ -17,13 +18,27 @@ Type VariableNode::getType()
     return this->type;
 }
 
-std::string VariableNode::getIdentifier()
+std::string_view VariableNode::getIdentifier()
 {
     return this->identifier;
 }
 
+Symbol VariableNode::getSymbol()
+{
+    return this->symbol;
+}
+
 void VariableNode::setType(Type type)
 {
     this->type = type;
 }
 
+int VariableNode::getSlot()
+{
+    return this->slot;
+}
+
+void VariableNode::setBinding(int slot)
+{
+    this->slot = slot;
+}
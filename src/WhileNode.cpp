@@ -1,7 +1,7 @@
 #include "../include/WhileNode.h"
 #include "../include/Visitor.h"
 
-WhileNode::WhileNode(ASTNode* condition, ASTNode* body)
+WhileNode::WhileNode(ASTNode* condition, ASTNode* body) : ASTNode(WhileKind)
 {
     this->condition = condition;
     this->body = body;
@@ -0,0 +1,560 @@
+#include "../include/x86Lowering.h"
+#include <algorithm>
+
+namespace
+{
+    //The first PreservedCount registers are callee-saved
+    const int RegisterCount = 6, PreservedCount = 5;
+    const std::string_view registerNames[RegisterCount]{
+        "%rbx",
+        "%r12",
+        "%r13",
+        "%r14",
+        "%r15",
+        "%r10"
+    };
+    const std::string_view argumentRegisters[6]{
+        "%rdi",
+        "%rsi",
+        "%rdx",
+        "%rcx",
+        "%r8",
+        "%r9"
+    };
+}
+
+/**
+ * Constructor. The assembly is written to the given sink, and the function
+ * index keeps the labels of different functions apart.
+ */
+x86Lowering::x86Lowering(OutputSink& out, int functionIndex) : out{ out }, functionIndex{ functionIndex }, allocator{ RegisterCount, PreservedCount } {}
+
+/**
+ * Writes what comes before the functions: the directives and the string
+ * literals of the program
+ */
+void x86Lowering::writeHeader(OutputSink& out, const StringPool& strings)
+{
+    out << ".global main\n";
+    out << ".data\n";
+    out << ".text\n\n";
+
+    for (uint32_t i = 0; i < strings.size(); i++)
+    {
+        out << StringPool::getLabel(i) << ":\n";
+        out << "\t.string " << strings.getText(i) << "\n";
+    }
+}
+
+/**
+ * Writes the assembly of a function, or returns false without writing
+ * anything if the function cannot be lowered
+ */
+bool x86Lowering::lower(const TACFunction& function)
+{
+    if (!checkCallingConvention(function))
+    {
+        return false;
+    }
+    this->function = &function;
+    allocator.allocate(function);
+    useCounts.assign(function.registerCount, 0);
+    //Only slots that are still loaded or stored take up space in the frame
+    slotCount = 0;
+    for (const BasicBlock& block : function.blocks)
+    {
+        for (const TACInstruction& instruction : block.instructions)
+        {
+            for (const TACOperand* operand : { &instruction.a, &instruction.b })
+            {
+                if (operand->isRegister())
+                {
+                    useCounts[operand->getRegister()]++;
+                }
+            }
+            if (instruction.op == LoadOp || instruction.op == StoreOp)
+            {
+                slotCount = std::max(slotCount, (uint32_t)instruction.a.value + 1);
+            }
+        }
+    }
+
+    //Size the frame so the stack stays 16-byte aligned once the callee-saved registers are pushed
+    std::vector<std::string_view> saved;
+    for (int i = 0; i < PreservedCount; i++)
+    {
+        if ((allocator.getUsedRegisters() >> i) & 1)
+        {
+            saved.push_back(registerNames[i]);
+        }
+    }
+    uint32_t frameSize = 8 * (slotCount + allocator.getSpillSlotCount());
+    if ((frameSize + 8 * saved.size()) % 16)
+    {
+        frameSize += 8;
+    }
+
+    out << "\n" << function.name << ":\n";
+    out << "\tpushq %rbp \t\t# save the base pointer\n\tmovq %rsp, %rbp \t# set new base pointer\n";
+    if (frameSize)
+    {
+        out << "\tsubq $" << frameSize << ", %rsp\n";
+    }
+    for (std::string_view machineRegister : saved)
+    {
+        out << "\tpushq " << machineRegister << "\n";
+    }
+
+    for (BlockId id = 0; id < function.blocks.size(); id++)
+    {
+        if (id != 0)
+        {
+            writeLabel(id);
+            out << ":\n";
+        }
+        for (size_t i = 0; i < function.blocks[id].instructions.size(); i++)
+        {
+            lowerInstruction(id, i);
+        }
+    }
+
+    //Returns jump to a label just past the last block
+    writeLabel((BlockId)function.blocks.size());
+    out << ":\n";
+    for (auto machineRegister = saved.rbegin(); machineRegister != saved.rend(); ++machineRegister)
+    {
+        out << "\tpopq " << *machineRegister << "\n";
+    }
+    out << "\tmovq %rbp, %rsp\t\t# reset stack to base pointer.\n"
+        "\tpopq %rbp \t\t# restore the old base pointer\n"
+        "\tret\t\t\t# return to caller\n";
+    return true;
+}
+
+const std::vector<std::string>& x86Lowering::getErrors()
+{
+    return errors;
+}
+
+/**
+ * Parameters and arguments are only passed in registers, so a function can
+ * have at most 6 of each
+ */
+bool x86Lowering::checkCallingConvention(const TACFunction& function)
+{
+    const std::string prefix = "Error in function \"" + std::string(function.name) + "\": ";
+    if (function.parameterCount > 6)
+    {
+        errors.push_back(prefix + "More than 6 parameters");
+    }
+    for (const BasicBlock& block : function.blocks)
+    {
+        for (const TACInstruction& instruction : block.instructions)
+        {
+            if (instruction.op == ArgumentOp && instruction.a.value >= 6)
+            {
+                errors.push_back(prefix + "More than 6 arguments in a call");
+                return false;
+            }
+        }
+    }
+    return errors.empty();
+}
+
+void x86Lowering::lowerInstruction(BlockId block, size_t index)
+{
+    const std::vector<TACInstruction>& instructions = function->blocks[block].instructions;
+    const TACInstruction& instruction = instructions[index];
+    switch (instruction.op)
+    {
+        case MoveOp:
+            moveToResult(instruction.a, instruction.result);
+            break;
+        case AddOp:
+        case SubtractOp:
+        case MultiplyOp:
+            lowerArithmetic(instruction);
+            break;
+        case DivideOp:
+            moveToRegister(instruction.a, "%rax");
+            out << "\tcqto\n";
+            if (instruction.b.isRegister())
+            {
+                out << "\tidivq ";
+                writeOperand(instruction.b);
+                out << "\n";
+            }
+            else
+            {
+                moveToRegister(instruction.b, "%r11");
+                out << "\tidivq %r11\n";
+            }
+            moveFromRegister("%rax", instruction.result);
+            break;
+        case LessThanOp:
+        case LessThanOrEqualToOp:
+        case GreaterThanOp:
+        case GreaterThanOrEqualToOp:
+        case EqualsOp:
+        {
+            //A comparison used only by the branch right after it becomes part of the branch
+            bool isFused = index + 1 < instructions.size() && instructions[index + 1].op == BranchOp
+                && instructions[index + 1].a == TACOperand::makeRegister(instruction.result) && useCounts[instruction.result] == 1;
+            if (!isFused)
+            {
+                lowerComparison(instruction);
+            }
+            break;
+        }
+        case ParameterOp:
+            moveFromRegister(argumentRegisters[instruction.a.value], instruction.result);
+            break;
+        case LoadOp:
+            if (isInMemory(TACOperand::makeRegister(instruction.result)))
+            {
+                out << "\tmovq ";
+                writeSlot((uint32_t)instruction.a.value);
+                out << ", %r11\n";
+                moveFromRegister("%r11", instruction.result);
+            }
+            else
+            {
+                out << "\tmovq ";
+                writeSlot((uint32_t)instruction.a.value);
+                out << ", " << registerNames[allocator.getRegister(instruction.result)] << "\n";
+            }
+            break;
+        case StoreOp:
+            if (isInMemory(instruction.b) || isLargeImmediate(instruction.b))
+            {
+                moveToRegister(instruction.b, "%r11");
+                out << "\tmovq %r11, ";
+            }
+            else
+            {
+                out << "\tmovq ";
+                writeOperand(instruction.b);
+                out << ", ";
+            }
+            writeSlot((uint32_t)instruction.a.value);
+            out << "\n";
+            break;
+        case ArgumentOp:
+            moveToRegister(instruction.b, argumentRegisters[instruction.a.value]);
+            break;
+        case CallOp:
+            out << "\tmovq $0, %rax\n";
+            out << "\tcall " << function->callees[instruction.a.value] << "\n";
+            if (useCounts[instruction.result])
+            {
+                moveFromRegister("%rax", instruction.result);
+            }
+            break;
+        case JumpOp:
+            jumpTo(block, function->blocks[block].successors[0]);
+            break;
+        case BranchOp:
+        {
+            const TACInstruction* comparison = nullptr;
+            if (index > 0 && instruction.a.isRegister() && instructions[index - 1].result == instruction.a.getRegister()
+                && instructions[index - 1].op >= LessThanOp && instructions[index - 1].op <= EqualsOp && useCounts[instruction.a.getRegister()] == 1)
+            {
+                comparison = &instructions[index - 1];
+            }
+            lowerBranch(block, instruction, comparison);
+            break;
+        }
+        case ReturnOp:
+            moveToRegister(instruction.a, "%rax");
+            jumpTo(block, (BlockId)function->blocks.size());
+            break;
+    }
+}
+
+/**
+ * Lowers an addition, subtraction or multiplication. x86 overwrites the
+ * left operand, so the left value is first moved into the result's
+ * register, or into %rax when the result is spilled or that move would
+ * overwrite the right value.
+ */
+void x86Lowering::lowerArithmetic(const TACInstruction& instruction)
+{
+    TACOperand a = instruction.a, b = instruction.b;
+    int target = allocator.getRegister(instruction.result);
+    auto isInTarget = [&](const TACOperand& operand)
+    {
+        return target != RegisterAllocator::Spilled && operand.isRegister() && allocator.getRegister(operand.getRegister()) == target;
+    };
+    if (instruction.op != SubtractOp && isInTarget(b) && !isInTarget(a))
+    {
+        std::swap(a, b);
+    }
+
+    std::string_view machineRegister = "%rax";
+    if (target != RegisterAllocator::Spilled && !(isInTarget(b) && !isInTarget(a)))
+    {
+        machineRegister = registerNames[target];
+    }
+    std::string_view mnemonic = instruction.op == AddOp ? "addq" : instruction.op == SubtractOp ? "subq" : "imulq";
+
+    moveToRegister(a, machineRegister);
+    if (isLargeImmediate(b))
+    {
+        moveToRegister(b, "%r11");
+        out << "\t" << mnemonic << " %r11, " << machineRegister << "\n";
+    }
+    else
+    {
+        out << "\t" << mnemonic << " ";
+        writeOperand(b);
+        out << ", " << machineRegister << "\n";
+    }
+    moveFromRegister(machineRegister, instruction.result);
+}
+
+/**
+ * Lowers a comparison whose value is needed as 0 or 1
+ */
+void x86Lowering::lowerComparison(const TACInstruction& instruction)
+{
+    TACOpcode condition = compare(instruction);
+    out << "\tset" << getConditionCode(condition, false) << " %al\n";
+    if (isInMemory(TACOperand::makeRegister(instruction.result)))
+    {
+        out << "\tmovzbq %al, %rax\n";
+        moveFromRegister("%rax", instruction.result);
+    }
+    else
+    {
+        out << "\tmovzbq %al, " << registerNames[allocator.getRegister(instruction.result)] << "\n";
+    }
+}
+
+/**
+ * Sets the flags for a comparison of its left operand against its right and
+ * returns the comparison the flags should be tested for. An immediate on the
+ * left is compared from the right instead, with the comparison mirrored, so
+ * it does not have to be loaded into a register first.
+ */
+TACOpcode x86Lowering::compare(const TACInstruction& comparison)
+{
+    if (comparison.a.isImmediate() && !isLargeImmediate(comparison.a) && comparison.b.isRegister())
+    {
+        out << "\tcmpq ";
+        writeOperand(comparison.a);
+        out << ", ";
+        writeOperand(comparison.b);
+        out << "\n";
+        switch (comparison.op)
+        {
+            case LessThanOp:
+                return GreaterThanOp;
+            case LessThanOrEqualToOp:
+                return GreaterThanOrEqualToOp;
+            case GreaterThanOp:
+                return LessThanOp;
+            case GreaterThanOrEqualToOp:
+                return LessThanOrEqualToOp;
+            default:
+                return comparison.op;
+        }
+    }
+
+    std::string_view left = "%rax";
+    if (comparison.a.isRegister() && !isInMemory(comparison.a))
+    {
+        left = registerNames[allocator.getRegister(comparison.a.getRegister())];
+    }
+    else
+    {
+        moveToRegister(comparison.a, left);
+    }
+
+    if (isLargeImmediate(comparison.b))
+    {
+        moveToRegister(comparison.b, "%r11");
+        out << "\tcmpq %r11, " << left << "\n";
+    }
+    else
+    {
+        out << "\tcmpq ";
+        writeOperand(comparison.b);
+        out << ", " << left << "\n";
+    }
+    return comparison.op;
+}
+
+/**
+ * Lowers a branch, falling through to whichever successor is laid out next
+ * when possible. If the condition is the comparison right before the branch,
+ * the branch jumps on the comparison's flags directly.
+ */
+void x86Lowering::lowerBranch(BlockId block, const TACInstruction& instruction, const TACInstruction* comparison)
+{
+    BlockId ifTrue = function->blocks[block].successors[0], ifFalse = function->blocks[block].successors[1];
+    TACOpcode condition = EqualsOp;
+    bool isInverted = true;
+    if (comparison)
+    {
+        condition = compare(*comparison);
+        isInverted = false;
+    }
+    else if (instruction.a.isRegister())
+    {
+        //Test the value against zero and jump if it is not equal
+        out << "\tcmpq $0, ";
+        writeOperand(instruction.a);
+        out << "\n";
+    }
+    else
+    {
+        bool isTaken = !(instruction.a.isImmediate() && instruction.a.value == 0);
+        jumpTo(block, isTaken ? ifTrue : ifFalse);
+        return;
+    }
+
+    if (ifTrue == block + 1)
+    {
+        out << "\tj" << getConditionCode(condition, !isInverted) << " ";
+        writeLabel(ifFalse);
+        out << "\n";
+        return;
+    }
+    out << "\tj" << getConditionCode(condition, isInverted) << " ";
+    writeLabel(ifTrue);
+    out << "\n";
+    jumpTo(block, ifFalse);
+}
+
+/**
+ * Jumps from the end of one block to another, unless the other is laid out next
+ */
+void x86Lowering::jumpTo(BlockId from, BlockId to)
+{
+    if (to != from + 1)
+    {
+        out << "\tjmp ";
+        writeLabel(to);
+        out << "\n";
+    }
+}
+
+std::string_view x86Lowering::getConditionCode(TACOpcode op, bool isInverted)
+{
+    switch (op)
+    {
+        case LessThanOp:
+            return isInverted ? "ge" : "l";
+        case LessThanOrEqualToOp:
+            return isInverted ? "g" : "le";
+        case GreaterThanOp:
+            return isInverted ? "le" : "g";
+        case GreaterThanOrEqualToOp:
+            return isInverted ? "l" : "ge";
+        default:
+            return isInverted ? "ne" : "e";
+    }
+}
+
+bool x86Lowering::isInMemory(const TACOperand& operand) const
+{
+    return operand.isRegister() && allocator.getRegister(operand.getRegister()) == RegisterAllocator::Spilled;
+}
+
+bool x86Lowering::isInRegister(const TACOperand& operand, std::string_view machineRegister) const
+{
+    return operand.isRegister() && !isInMemory(operand) && registerNames[allocator.getRegister(operand.getRegister())] == machineRegister;
+}
+
+/**
+ * Returns whether the operand is an immediate that does not fit in the 32
+ * bits most instructions accept
+ */
+bool x86Lowering::isLargeImmediate(const TACOperand& operand)
+{
+    return operand.isImmediate() && (operand.value < INT32_MIN || operand.value > INT32_MAX);
+}
+
+void x86Lowering::writeOperand(const TACOperand& operand)
+{
+    switch (operand.kind)
+    {
+        case RegisterOperand:
+        {
+            VirtualRegister reg = operand.getRegister();
+            if (allocator.getRegister(reg) == RegisterAllocator::Spilled)
+            {
+                //Spill slots come after the function's locals
+                writeSlot(slotCount + allocator.getSpillSlot(reg));
+            }
+            else
+            {
+                out << registerNames[allocator.getRegister(reg)];
+            }
+            break;
+        }
+        case ImmediateOperand:
+            out << "$" << operand.value;
+            break;
+        case StringOperand:
+            out << "$" << StringPool::getLabel((uint32_t)operand.value);
+            break;
+        default:
+            break;
+    }
+}
+
+void x86Lowering::writeSlot(uint32_t slot)
+{
+    out << -8 * ((int64_t)slot + 1) << "(%rbp)";
+}
+
+void x86Lowering::writeLabel(BlockId block)
+{
+    out << ".L" << functionIndex << "_" << block;
+}
+
+void x86Lowering::moveToRegister(const TACOperand& source, std::string_view machineRegister)
+{
+    if (isInRegister(source, machineRegister))
+    {
+        return;
+    }
+    out << "\tmovq ";
+    writeOperand(source);
+    out << ", " << machineRegister << "\n";
+}
+
+void x86Lowering::moveFromRegister(std::string_view machineRegister, VirtualRegister result)
+{
+    TACOperand destination = TACOperand::makeRegister(result);
+    if (isInRegister(destination, machineRegister))
+    {
+        return;
+    }
+    out << "\tmovq " << machineRegister << ", ";
+    writeOperand(destination);
+    out << "\n";
+}
+
+void x86Lowering::moveToResult(const TACOperand& source, VirtualRegister result)
+{
+    TACOperand destination = TACOperand::makeRegister(result);
+    if (source.isRegister() && !isInMemory(source))
+    {
+        moveFromRegister(registerNames[allocator.getRegister(source.getRegister())], result);
+    }
+    else if (isInMemory(destination))
+    {
+        if (source == destination)
+        {
+            return;
+        }
+        moveToRegister(source, "%r11");
+        moveFromRegister("%r11", result);
+    }
+    else
+    {
+        moveToRegister(source, registerNames[allocator.getRegister(result)]);
+    }
+}
@@ -0,0 +1,84 @@
+#include <string>
+#include "ConstantPropagator.h"
+#include "DeadCodeEliminator.h"
+#include "GenTACVisitor.h"
+#include "OutputSink.h"
+#include "Parser.h"
+#include "ProgramNode.h"
+#include "SSABuilder.h"
+#include "SSADestructor.h"
+#include "Test.h"
+#include "TypeCheckingVisitor.h"
+#include "ValueNumberer.h"
+#include "x86Lowering.h"
+
+/**
+ * Parses and type checks a program, returning null if either fails. The
+ * tree lives as long as the parser.
+ */
+static ProgramNode* parse(Parser& parser)
+{
+    ASTNode* program = parser.parseProgram();
+    TypeCheckingVisitor typeChecker;
+    if (!program || !typeChecker.check(program))
+    {
+        return nullptr;
+    }
+    return static_cast<ProgramNode*>(program);
+}
+
+/**
+ * Compiles every function of a program through the same passes as the
+ * driver, returning false if any stage fails
+ */
+static bool compile(const std::string& text)
+{
+    Parser parser(Test::writeProgram("code_generation_test.pr", text));
+    ProgramNode* program = parse(parser);
+    if (!program)
+    {
+        return false;
+    }
+    for (ASTNode* unit : program->getProgramUnits())
+    {
+        GenTACVisitor generator;
+        TACFunction function = generator.generate(unit);
+        SSABuilder().build(function);
+        ConstantPropagator().propagate(function);
+        DeadCodeEliminator().eliminate(function);
+        ValueNumberer().number(function);
+        SSADestructor().destruct(function);
+        BufferSink out;
+        if (!x86Lowering(out, 0).lower(function))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * Joins count copies of term with op between them
+ */
+static std::string getChain(const std::string& term, const std::string& op, size_t count)
+{
+    std::string chain = term;
+    for (size_t i = 1; i < count; i++)
+    {
+        chain += " " + op + " " + term;
+    }
+    return chain;
+}
+
+int main()
+{
+    //Long enough that generating the chain recursively overflows the native stack
+    const size_t Length = 200000;
+    Test::expect(compile("int main()\n{\n    int x = 1;\n    int y = " + getChain("x", "+", Length) + ";\n"
+        "    printf(\"%d\\n\", y);\n    return 0;\n}\n"), "a long + chain compiles");
+    Test::expect(compile("int main()\n{\n    int x = 1;\n    if (" + getChain("(x < 2)", "&&", Length) + ")\n    {\n"
+        "        x = 2;\n    }\n    return x;\n}\n"), "a long && condition compiles");
+    Test::expect(!compile("int f(int a, int b, int c, int d, int e, int g, int h)\n{\n    return a;\n}\n"
+        "int main()\n{\n    return f(1, 2, 3, 4, 5, 6, 7);\n}\n"), "more than 6 parameters is an error");
+    return Test::getExitCode();
+}
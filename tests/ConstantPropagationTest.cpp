@@ -0,0 +1,73 @@
+#include "ConstantPropagator.h"
+#include "Test.h"
+
+/**
+ * Branches on a condition computed from constants either to a block that
+ * jumps to a join, or straight to the join, where a phi picks the sum on
+ * the first path and 0 on the second
+ */
+static void testConstantBranch()
+{
+    TACFunction function;
+    for (int i = 0; i < 3; i++)
+    {
+        function.newBlock();
+    }
+    VirtualRegister sum = function.newRegister(), condition = function.newRegister(), result = function.newRegister();
+    function.blocks[0].instructions.push_back({ AddOp, sum, TACOperand::makeImmediate(2), TACOperand::makeImmediate(3) });
+    function.blocks[0].instructions.push_back({ LessThanOp, condition, TACOperand::makeRegister(sum), TACOperand::makeImmediate(10) });
+    function.blocks[0].instructions.push_back({ BranchOp, NoRegister, TACOperand::makeRegister(condition), {} });
+    function.addEdge(0, 1);
+    function.addEdge(0, 2);
+    function.blocks[1].instructions.push_back({ JumpOp, NoRegister, {}, {} });
+    function.addEdge(1, 2);
+    function.blocks[2].phis.push_back({ result, { TACOperand::makeImmediate(0), TACOperand::makeRegister(sum) } });
+    function.blocks[2].instructions.push_back({ ReturnOp, NoRegister, TACOperand::makeRegister(result), {} });
+
+    ConstantPropagator propagator;
+    propagator.propagate(function);
+    const BasicBlock& entry = function.blocks[0], & join = function.blocks[2];
+    Test::expect(entry.instructions.size() == 1 && entry.instructions[0].op == JumpOp && entry.successors == std::vector<BlockId>{ 1 },
+        "a branch on a constant condition becomes a jump");
+    Test::expect(join.predecessors == std::vector<BlockId>{ 1 }, "the edge not taken is removed");
+    Test::expect(join.phis.empty() && join.instructions[0].a == TACOperand::makeImmediate(5), "the phi folds to the value on the edge taken");
+    Test::expect(propagator.getPrunedBranchCount() == 1 && propagator.getFoldedCount() == 3, "the pruned branch and folded values are counted");
+}
+
+/**
+ * Multiplies a value by 1 around a loop whose exit depends on a parameter,
+ * so the value is constant but the branch is not
+ */
+static void testLoop()
+{
+    TACFunction function;
+    for (int i = 0; i < 4; i++)
+    {
+        function.newBlock();
+    }
+    VirtualRegister parameter = function.newRegister(), value = function.newRegister(), product = function.newRegister();
+    function.blocks[0].instructions.push_back({ ParameterOp, parameter, TACOperand::makeImmediate(0), {} });
+    function.blocks[0].instructions.push_back({ JumpOp, NoRegister, {}, {} });
+    function.addEdge(0, 1);
+    function.blocks[1].phis.push_back({ value, { TACOperand::makeImmediate(1), TACOperand::makeRegister(product) } });
+    function.blocks[1].instructions.push_back({ BranchOp, NoRegister, TACOperand::makeRegister(parameter), {} });
+    function.addEdge(1, 2);
+    function.addEdge(1, 3);
+    function.blocks[2].instructions.push_back({ MultiplyOp, product, TACOperand::makeRegister(value), TACOperand::makeImmediate(1) });
+    function.blocks[2].instructions.push_back({ JumpOp, NoRegister, {}, {} });
+    function.addEdge(2, 1);
+    function.blocks[3].instructions.push_back({ ReturnOp, NoRegister, TACOperand::makeRegister(value), {} });
+
+    ConstantPropagator propagator;
+    propagator.propagate(function);
+    Test::expect(function.blocks[3].instructions[0].a == TACOperand::makeImmediate(1), "a value that stays the same around a loop is constant");
+    Test::expect(function.blocks[1].instructions[0].op == BranchOp && function.blocks[1].successors.size() == 2, "a branch on a parameter is kept");
+    Test::expect(propagator.getPrunedBranchCount() == 0, "no branch is pruned");
+}
+
+int main()
+{
+    testConstantBranch();
+    testLoop();
+    return Test::getExitCode();
+}
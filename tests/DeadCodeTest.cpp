@@ -0,0 +1,42 @@
+#include "DeadCodeEliminator.h"
+#include "Test.h"
+
+/**
+ * Makes an unused product and an unused call in the entry, which jumps to a
+ * block whose phi also has an operand from a block nothing reaches
+ */
+static void testDeadCode()
+{
+    TACFunction function;
+    function.callees.push_back("f");
+    for (int i = 0; i < 3; i++)
+    {
+        function.newBlock();
+    }
+    VirtualRegister parameter = function.newRegister(), product = function.newRegister(), call = function.newRegister(), result = function.newRegister();
+    function.blocks[0].instructions.push_back({ ParameterOp, parameter, TACOperand::makeImmediate(0), {} });
+    function.blocks[0].instructions.push_back({ MultiplyOp, product, TACOperand::makeRegister(parameter), TACOperand::makeImmediate(3) });
+    function.blocks[0].instructions.push_back({ CallOp, call, TACOperand::makeImmediate(0), TACOperand::makeImmediate(0) });
+    function.blocks[0].instructions.push_back({ JumpOp, NoRegister, {}, {} });
+    function.addEdge(0, 1);
+    function.blocks[2].instructions.push_back({ JumpOp, NoRegister, {}, {} });
+    function.addEdge(2, 1);
+    function.blocks[1].phis.push_back({ result, { TACOperand::makeRegister(parameter), TACOperand::makeImmediate(7) } });
+    function.blocks[1].instructions.push_back({ ReturnOp, NoRegister, TACOperand::makeRegister(result), {} });
+
+    DeadCodeEliminator eliminator;
+    eliminator.eliminate(function);
+    Test::expect(function.blocks.size() == 2, "the unreachable block is removed");
+    const BasicBlock& entry = function.blocks[0], & exit = function.blocks[1];
+    Test::expect(exit.predecessors == std::vector<BlockId>{ 0 } && exit.phis.size() == 1 && exit.phis[0].incoming == std::vector<TACOperand>{ TACOperand::makeRegister(parameter) },
+        "the phi loses the operand from the removed block");
+    Test::expect(entry.instructions.size() == 3 && entry.instructions[0].op == ParameterOp && entry.instructions[1].op == CallOp,
+        "the unused product is removed and the unused call is kept");
+    Test::expect(eliminator.getRemovedBlockCount() == 1 && eliminator.getRemovedInstructionCount() == 2, "the removed block and instructions are counted");
+}
+
+int main()
+{
+    testDeadCode();
+    return Test::getExitCode();
+}
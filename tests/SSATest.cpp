@@ -0,0 +1,153 @@
+#include <map>
+#include "SSABuilder.h"
+#include "SSADestructor.h"
+#include "Test.h"
+
+/**
+ * Builds a function that branches on its parameter from the entry to
+ * blocks 1 and 2, and returns the function with the parameter in register 0
+ */
+static TACFunction getBranch()
+{
+    TACFunction function;
+    function.parameterCount = 1;
+    for (int i = 0; i < 3; i++)
+    {
+        function.newBlock();
+    }
+    VirtualRegister parameter = function.newRegister();
+    function.blocks[0].instructions.push_back({ ParameterOp, parameter, TACOperand::makeImmediate(0), {} });
+    function.blocks[0].instructions.push_back({ BranchOp, NoRegister, TACOperand::makeRegister(parameter), {} });
+    function.addEdge(0, 1);
+    function.addEdge(0, 2);
+    return function;
+}
+
+static bool hasSlotAccess(const TACFunction& function)
+{
+    for (const BasicBlock& block : function.blocks)
+    {
+        for (const TACInstruction& instruction : block.instructions)
+        {
+            if (instruction.op == LoadOp || instruction.op == StoreOp)
+            {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+/**
+ * Stores a different value to slot 0 on each side of a diamond and returns
+ * it from the join, along with slot 1, which is only stored in the entry
+ */
+static void testPhiPlacement()
+{
+    TACFunction function = getBranch();
+    function.slotCount = 2;
+    BlockId join = function.newBlock();
+    function.blocks[0].instructions.insert(function.blocks[0].instructions.begin(), { StoreOp, NoRegister, TACOperand::makeImmediate(1), TACOperand::makeImmediate(5) });
+    function.blocks[1].instructions.push_back({ StoreOp, NoRegister, TACOperand::makeImmediate(0), TACOperand::makeImmediate(1) });
+    function.blocks[1].instructions.push_back({ JumpOp, NoRegister, {}, {} });
+    function.blocks[2].instructions.push_back({ StoreOp, NoRegister, TACOperand::makeImmediate(0), TACOperand::makeImmediate(2) });
+    function.blocks[2].instructions.push_back({ JumpOp, NoRegister, {}, {} });
+    function.addEdge(1, join);
+    function.addEdge(2, join);
+    VirtualRegister value = function.newRegister(), other = function.newRegister(), sum = function.newRegister();
+    function.blocks[join].instructions.push_back({ LoadOp, value, TACOperand::makeImmediate(0), {} });
+    function.blocks[join].instructions.push_back({ LoadOp, other, TACOperand::makeImmediate(1), {} });
+    function.blocks[join].instructions.push_back({ AddOp, sum, TACOperand::makeRegister(value), TACOperand::makeRegister(other) });
+    function.blocks[join].instructions.push_back({ ReturnOp, NoRegister, TACOperand::makeRegister(sum), {} });
+
+    SSABuilder().build(function);
+    const BasicBlock& block = function.blocks[join];
+    Test::expect(!hasSlotAccess(function), "every load and store is removed");
+    Test::expect(function.blocks[1].phis.empty() && function.blocks[2].phis.empty(), "no phis are placed outside the join");
+    Test::expect(block.phis.size() == 1, "only the slot stored on both sides gets a phi");
+    if (block.phis.size() == 1)
+    {
+        const TACPhi& phi = block.phis[0];
+        Test::expect(phi.incoming.size() == 2 && phi.incoming[0] == TACOperand::makeImmediate(1) && phi.incoming[1] == TACOperand::makeImmediate(2),
+            "the phi takes each side's store in predecessor order");
+        Test::expect(block.instructions.size() == 2 && block.instructions[0].a == TACOperand::makeRegister(phi.result)
+            && block.instructions[0].b == TACOperand::makeImmediate(5), "loads are replaced by the phi and by the entry's store");
+    }
+}
+
+/**
+ * Sends the entry straight to a join that block 1 also jumps to, so the
+ * entry's edge to the join is critical
+ */
+static void testCriticalEdgeSplitting()
+{
+    TACFunction function = getBranch();
+    VirtualRegister result = function.newRegister();
+    function.blocks[1].instructions.push_back({ JumpOp, NoRegister, {}, {} });
+    function.addEdge(1, 2);
+    function.blocks[2].phis.push_back({ result, { TACOperand::makeImmediate(1), TACOperand::makeImmediate(2) } });
+    function.blocks[2].instructions.push_back({ ReturnOp, NoRegister, TACOperand::makeRegister(result), {} });
+
+    SSADestructor().destruct(function);
+    Test::expect(function.blocks.size() == 4, "the critical edge gets a block of its own");
+    if (function.blocks.size() != 4)
+    {
+        return;
+    }
+    //The new block is laid out right after the entry, which moves the others up by one
+    const BasicBlock& edge = function.blocks[1];
+    Test::expect(function.blocks[0].successors == std::vector<BlockId>{ 2, 1 }, "the entry's branch is redirected to the new block");
+    Test::expect(edge.predecessors == std::vector<BlockId>{ 0 } && edge.successors == std::vector<BlockId>{ 3 }, "the new block leads from the entry to the join");
+    Test::expect(edge.instructions.size() == 2 && edge.instructions[0].op == MoveOp && edge.instructions[0].result == result
+        && edge.instructions[0].a == TACOperand::makeImmediate(1) && edge.instructions[1].op == JumpOp, "the entry's copy goes in the new block");
+    const BasicBlock& side = function.blocks[2];
+    Test::expect(side.instructions.size() == 2 && side.instructions[0].op == MoveOp && side.instructions[0].a == TACOperand::makeImmediate(2),
+        "a predecessor with one successor holds its own copy");
+    Test::expect(function.blocks[3].phis.empty() && function.blocks[3].predecessors == std::vector<BlockId>{ 1, 2 }, "the join's phi is gone");
+}
+
+/**
+ * Swaps two registers around a loop, so the copies on the back edge read
+ * each other's destinations
+ */
+static void testCopyCycle()
+{
+    TACFunction function;
+    for (int i = 0; i < 4; i++)
+    {
+        function.newBlock();
+    }
+    VirtualRegister parameter = function.newRegister(), a = function.newRegister(), b = function.newRegister();
+    function.blocks[0].instructions.push_back({ ParameterOp, parameter, TACOperand::makeImmediate(0), {} });
+    function.blocks[0].instructions.push_back({ JumpOp, NoRegister, {}, {} });
+    function.addEdge(0, 1);
+    function.blocks[1].phis.push_back({ a, { TACOperand::makeImmediate(1), TACOperand::makeRegister(b) } });
+    function.blocks[1].phis.push_back({ b, { TACOperand::makeImmediate(2), TACOperand::makeRegister(a) } });
+    function.blocks[1].instructions.push_back({ BranchOp, NoRegister, TACOperand::makeRegister(parameter), {} });
+    function.addEdge(1, 2);
+    function.addEdge(1, 3);
+    function.blocks[2].instructions.push_back({ JumpOp, NoRegister, {}, {} });
+    function.addEdge(2, 1);
+    function.blocks[3].instructions.push_back({ ReturnOp, NoRegister, TACOperand::makeRegister(a), {} });
+
+    SSADestructor().destruct(function);
+    //Run the back edge's copies one after another
+    std::map<VirtualRegister, int64_t> registers = { { a, 10 }, { b, 20 } };
+    for (const TACInstruction& instruction : function.blocks[2].instructions)
+    {
+        if (instruction.op == MoveOp)
+        {
+            registers[instruction.result] = instruction.a.isRegister() ? registers[instruction.a.getRegister()] : instruction.a.value;
+        }
+    }
+    Test::expect(registers[a] == 20 && registers[b] == 10, "copies that form a cycle still swap their registers");
+    Test::expect(function.blocks[2].instructions.size() == 4, "a cycle of two copies takes one extra copy");
+}
+
+int main()
+{
+    testPhiPlacement();
+    testCriticalEdgeSplitting();
+    testCopyCycle();
+    return Test::getExitCode();
+}
@@ -0,0 +1,39 @@
+#ifndef TEST_H
+#define TEST_H
+#include <fstream>
+#include <iostream>
+#include <string>
+
+/**
+ * Shared pieces of the test drivers. Each driver is a plain executable that
+ * reports every failed expectation and exits with a failure if there was one.
+ */
+namespace Test
+{
+    inline int failureCount = 0;
+
+    inline void expect(bool condition, const std::string& description)
+    {
+        if (!condition)
+        {
+            std::cerr << "FAILED: " << description << "\n";
+            failureCount++;
+        }
+    }
+
+    inline int getExitCode()
+    {
+        return failureCount ? EXIT_FAILURE : 0;
+    }
+
+    /**
+     * Writes a program to a file in the working directory, since the parser
+     * reads its input from disk, and returns the path
+     */
+    inline std::string writeProgram(const std::string& name, const std::string& text)
+    {
+        std::ofstream(name, std::ios::binary) << text;
+        return name;
+    }
+}
+#endif
@@ -0,0 +1,47 @@
+#include <string>
+#include "Parser.h"
+#include "Test.h"
+#include "TypeCheckingVisitor.h"
+
+/**
+ * Parses and type checks a program, returning false if either fails
+ */
+static bool check(const std::string& text)
+{
+    Parser parser(Test::writeProgram("type_checking_test.pr", text));
+    ASTNode* program = parser.parseProgram();
+    if (!program)
+    {
+        return false;
+    }
+    TypeCheckingVisitor typeChecker;
+    return typeChecker.check(program);
+}
+
+/**
+ * A program that stores the comparison in a variable of the given type and
+ * branches and loops on it
+ */
+static std::string getComparisonProgram(const std::string& op, const std::string& type)
+{
+    return "int main()\n{\n"
+        "    int x = 1;\n"
+        "    " + type + " result = x " + op + " 2;\n"
+        "    if (x " + op + " 2)\n    {\n        x = 3;\n    }\n"
+        "    while (x " + op + " 0)\n    {\n        x = x - 1;\n    }\n"
+        "    return x;\n}\n";
+}
+
+int main()
+{
+    for (const char* op : { "<", "<=", ">", ">=", "==" })
+    {
+        Test::expect(check(getComparisonProgram(op, "bool")), std::string("x ") + op + " 2 is a bool");
+        Test::expect(!check(getComparisonProgram(op, "int")), std::string("x ") + op + " 2 is not an int");
+    }
+    Test::expect(!check("int main()\n{\n    bool b = true <= false;\n    return 0;\n}\n"), "booleans cannot be ordered");
+    Test::expect(!check("int main()\n{\n    int x = 3;\n    4 = x;\n    return x;\n}\n"), "only a variable can be assigned to");
+    Test::expect(check("int main()\n{\n    return 2147483647;\n}\n"), "the largest int literal is accepted");
+    Test::expect(!check("int main()\n{\n    return 3000000000;\n}\n"), "an int literal that does not fit is an error");
+    return Test::getExitCode();
+}
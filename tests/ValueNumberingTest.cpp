@@ -0,0 +1,52 @@
+#include "Test.h"
+#include "ValueNumberer.h"
+
+/**
+ * Adds the two parameters in the entry and again, the other way round, on
+ * one side of a branch. Each side also multiplies them, and a join picks
+ * between the products and between the sums.
+ */
+static void testDominatingComputation()
+{
+    TACFunction function;
+    for (int i = 0; i < 4; i++)
+    {
+        function.newBlock();
+    }
+    VirtualRegister p = function.newRegister(), q = function.newRegister(), sum = function.newRegister(), repeatedSum = function.newRegister(),
+        leftProduct = function.newRegister(), rightProduct = function.newRegister(), product = function.newRegister(), pickedSum = function.newRegister(),
+        result = function.newRegister();
+    TACOperand a = TACOperand::makeRegister(p), b = TACOperand::makeRegister(q);
+    function.blocks[0].instructions.push_back({ ParameterOp, p, TACOperand::makeImmediate(0), {} });
+    function.blocks[0].instructions.push_back({ ParameterOp, q, TACOperand::makeImmediate(1), {} });
+    function.blocks[0].instructions.push_back({ AddOp, sum, a, b });
+    function.blocks[0].instructions.push_back({ BranchOp, NoRegister, a, {} });
+    function.addEdge(0, 1);
+    function.addEdge(0, 2);
+    function.blocks[1].instructions.push_back({ AddOp, repeatedSum, b, a });
+    function.blocks[1].instructions.push_back({ MultiplyOp, leftProduct, a, b });
+    function.blocks[1].instructions.push_back({ JumpOp, NoRegister, {}, {} });
+    function.addEdge(1, 3);
+    function.blocks[2].instructions.push_back({ MultiplyOp, rightProduct, a, b });
+    function.blocks[2].instructions.push_back({ JumpOp, NoRegister, {}, {} });
+    function.addEdge(2, 3);
+    function.blocks[3].phis.push_back({ product, { TACOperand::makeRegister(leftProduct), TACOperand::makeRegister(rightProduct) } });
+    function.blocks[3].phis.push_back({ pickedSum, { TACOperand::makeRegister(repeatedSum), TACOperand::makeRegister(sum) } });
+    function.blocks[3].instructions.push_back({ AddOp, result, TACOperand::makeRegister(product), TACOperand::makeRegister(pickedSum) });
+    function.blocks[3].instructions.push_back({ ReturnOp, NoRegister, TACOperand::makeRegister(result), {} });
+
+    ValueNumberer numberer;
+    numberer.number(function);
+    const BasicBlock& left = function.blocks[1], & right = function.blocks[2], & join = function.blocks[3];
+    Test::expect(left.instructions.size() == 2 && left.instructions[0].result == leftProduct, "a sum made in a dominating block is not made again");
+    Test::expect(right.instructions.size() == 2 && right.instructions[0].result == rightProduct, "a product made only on the other side is kept");
+    Test::expect(join.phis.size() == 1 && join.phis[0].result == product, "a phi of two equal values is removed");
+    Test::expect(join.instructions[0].b == TACOperand::makeRegister(sum), "reads of the removed phi use the first sum");
+    Test::expect(numberer.getEliminatedCount() == 2, "the repeated sum and the phi are counted");
+}
+
+int main()
+{
+    testDominatingComputation();
+    return Test::getExitCode();
+}